@@ -0,0 +1,126 @@
+#include "benchmark.h"
+
+#include <Tempest/Device>
+#include <Tempest/Log>
+#include <Tempest/MemWriter>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "game/gamescript.h"
+#include "game/gamesession.h"
+#include "game/serialize.h"
+#include "graphics/pfxobjects.h"
+#include "graphics/rendererstorage.h"
+#include "gothic.h"
+
+using namespace Tempest;
+
+static uint64_t fnv1a(const std::vector<uint8_t>& data) {
+  uint64_t h = 14695981039346656037ull;
+  for(auto i:data) {
+    h ^= i;
+    h *= 1099511628211ull;
+    }
+  return h;
+  }
+
+int Benchmark::run(Gothic& gothic, Device& device, uint32_t ticks) {
+  RendererStorage storage(device,gothic);
+
+  auto a = runPass(gothic,storage,ticks);
+  if(!a.ok)
+    return 1;
+  report("pass 1",a);
+
+  auto b = runPass(gothic,storage,ticks);
+  if(!b.ok)
+    return 1;
+  report("pass 2",b);
+
+  device.waitIdle();
+
+  char buf[128]={};
+  if(a.hash!=b.hash || a.bytes!=b.bytes) {
+    std::snprintf(buf,sizeof(buf),"%016llx != %016llx",
+                  static_cast<unsigned long long>(a.hash),static_cast<unsigned long long>(b.hash));
+    Log::e("benchmark: world state diverged after ",ticks," ticks: ",buf);
+    return 2;
+    }
+  std::snprintf(buf,sizeof(buf),"%016llx",static_cast<unsigned long long>(a.hash));
+  Log::i("benchmark: world state is deterministic, ",uint32_t(a.bytes)," bytes, hash ",buf);
+
+  if(a.lateFx>0) {
+    Log::e("benchmark: ",uint32_t(a.lateFx)," effect definitions were loaded after warmup");
+    return 3;
+    }
+  return 0;
+  }
+
+Benchmark::Pass Benchmark::runPass(Gothic& gothic, const RendererStorage& storage, uint32_t ticks) {
+  Pass ret;
+
+  std::srand(Seed);
+  PfxObjects::seed(Seed);
+  GameScript::seed(Seed);
+
+  std::unique_ptr<GameSession> game;
+  try {
+    game.reset(new GameSession(gothic,storage,gothic.defaultWorld()));
+    }
+  catch(std::runtime_error& e) {
+    Log::e("benchmark: unable to load world: ",e.what());
+    return ret;
+    }
+  gothic.setGame(std::move(game));
+
+  ret.tickNs.resize(ticks);
+  for(uint32_t i=0;i<ticks;++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    gothic.tick(Gothic::TickStep);
+    gothic.updateAnimation();
+    auto t1 = std::chrono::steady_clock::now();
+    ret.tickNs[i] = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count());
+    }
+
+  ret.lateFx = gothic.fxLateLoads();
+  game = gothic.clearGame();
+  if(game==nullptr) {
+    Log::e("benchmark: game session was closed by script");
+    return ret;
+    }
+
+  std::vector<uint8_t> data;
+  {
+  Tempest::MemWriter wr{data};
+  Serialize          fout{wr};
+  game->saveState(fout);
+  }
+  ret.hash  = fnv1a(data);
+  ret.bytes = data.size();
+  ret.ok    = true;
+  return ret;
+  }
+
+void Benchmark::report(const char* name, const Pass& p) {
+  if(p.tickNs.empty())
+    return;
+  auto t = p.tickNs;
+  std::sort(t.begin(),t.end());
+
+  uint64_t sum = 0;
+  for(auto i:t)
+    sum += i;
+
+  auto pct = [&t](double q) {
+    size_t id = size_t(double(t.size()-1)*q);
+    return double(t[id])/1e6;
+    };
+
+  char buf[256]={};
+  std::snprintf(buf,sizeof(buf),"mean %.3f, min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms/tick",
+                double(sum)/double(t.size())/1e6,pct(0),pct(0.5),pct(0.95),pct(0.99),pct(1));
+  Log::i("benchmark ",name,": ",uint32_t(t.size())," ticks, ",buf);
+  }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Tempest {
+class Device;
+}
+
+class Gothic;
+class RendererStorage;
+
+// Runs the world simulation for a fixed number of ticks without window or swapchain,
+// reports tick-time distribution and checks that two identical runs produce identical world state.
+class Benchmark final {
+  public:
+    static int run(Gothic& gothic, Tempest::Device& device, uint32_t ticks);
+
+  private:
+    enum : uint32_t {
+      Seed   = 0x5EED,
+      };
+
+    struct Pass final {
+      bool                  ok    =false;
+      std::vector<uint64_t> tickNs;
+      uint64_t              hash  =0;
+      size_t                bytes =0;
+      size_t                lateFx=0; // effect definitions loaded after world warmup
+      };
+
+    static Pass runPass(Gothic& gothic, const RendererStorage& storage, uint32_t ticks);
+    static void report (const char* name, const Pass& p);
+  };
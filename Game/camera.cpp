@@ -43,6 +43,7 @@ void Camera::implReset(const Npc &pl) {
   spin.x     = pl.rotation();
   spin.y     = 0;
   camPos.y  += tr + tr*(def.bestElevation-10)/20.f;
+  prevPos    = camPos;
   }
 
 void Camera::save(Serialize &s) {
@@ -60,6 +61,7 @@ void Camera::load(Serialize &s, Npc *pl) {
     return;
     }
   s.read(spin.x,spin.y,camPos,zoom,hasPos);
+  prevPos = camPos;
   }
 
 void Camera::changeZoom(int delta) {
@@ -108,61 +110,7 @@ void Camera::setDistance(float d) {
   clampZoom(dist);
   }
 
-Matrix4x4 Camera::viewShadow(const std::array<float,3>& ldir, int layer) const {
-  const float scale = 0.0008f;
-  const float c = std::cos(spin.x*float(M_PI)/180.f), s = std::sin(spin.x*float(M_PI)/180.f);
-
-  Matrix4x4 view;
-  if(ldir[1]>=0.f)
-    return view;
-
-  view.identity();
-
-  if(layer>0)
-    view.scale(0.2f);
-
-  view.translate(0.f,0.5f,0.5f);
-  view.rotate(/*spin.y*/90, 1, 0, 0);
-  view.translate(0.f,0.f,0.f);
-  view.rotate(spin.x, 0, 1, 0);
-  view.scale(scale,scale*0.3f,scale);
-  view.translate(camPos.x,camPos.y,camPos.z);
-  view.scale(-1,-1,-1);
-
-  auto inv = view;
-  inv.inverse();
-  float cx=0,cy=0,cz=0;
-  inv.project(cx,cy,cz);
-  cy=camPos.y;
-
-  float lx  = view.at(1,0);
-  float ly  = view.at(1,1);
-  float lz  = view.at(1,2);
-  float k   = ldir[1]!=0.f ? lz/ldir[1] : 0.f;
-
-  lx = -ldir[2]*k;
-  ly = -ldir[0]*k;
-
-  lz =  ldir[1]*k;
-
-  float dx = lx*c-ly*s;
-  float dy = lx*s+ly*c;
-
-  view.set(1,0, dx);
-  view.set(1,1, dy);
-  view.set(1,2, lz);
-
-  // float cx = camPos[0],
-  //       cy = camPos[1],
-  //       cz = camPos[2];
-  view.project(cx,cy,cz);
-  view.set(3,0, view.at(3,0)-cx);
-  view.set(3,1, view.at(3,1)-cy);
-
-  return view;
-  }
-
-Matrix4x4 Camera::mkView(float dist) const {
+Matrix4x4 Camera::mkView(const Vec3& pos, float dist) const {
   const float scale=0.0009f;
   Matrix4x4 view;
   view.identity();
@@ -170,7 +118,7 @@ Matrix4x4 Camera::mkView(float dist) const {
   view.rotate(spin.y, 1, 0, 0);
   view.rotate(spin.x, 0, 1, 0);
   view.scale(scale);
-  view.translate(camPos.x,camPos.y,camPos.z);
+  view.translate(pos.x,pos.y,pos.z);
   view.scale(-1,-1,-1);
   return view;
   }
@@ -232,6 +180,21 @@ void Camera::setPosition(float x, float y, float z) {
   camPos = {x,y,z};
   }
 
+void Camera::beginStep() {
+  prevPos = camPos;
+  }
+
+void Camera::setInterpolation(float k) {
+  lerpK = k;
+  }
+
+Vec3 Camera::viewPosition() const {
+  auto d = camPos-prevPos;
+  if(d.manhattanLength()>MaxLerpDistance)
+    return camPos;
+  return prevPos+d*lerpK;
+  }
+
 void Camera::follow(const Npc &npc,uint64_t dt,bool inMove,bool includeRot) {
   const auto& def = cameraDef();
   const float dtF = float(dt)/1000.f;
@@ -297,14 +260,16 @@ Matrix4x4 Camera::view() const {
   const float dist    = this->dist*100.f/zoom;
   const float minDist = 25;
 
+  const auto pos     = viewPosition();
+
   auto world = gothic.world();
   if(world==nullptr)
-    return mkView(dist);
+    return mkView(pos,dist);
 
   const auto proj = world->view()->projective();
 
   Matrix4x4 view=proj;
-  view.mul(mkView(dist));
+  view.mul(mkView(pos,dist));
 
   Matrix4x4 vinv=view;
   vinv.inverse();
@@ -315,7 +280,7 @@ Matrix4x4 Camera::view() const {
   for(int i=-n;i<=n;++i)
     for(int r=-n;r<=n;++r) {
       float u = float(i)/float(nn),v = float(r)/float(nn);
-      Tempest::Vec3 r0=camPos;
+      Tempest::Vec3 r0=pos;
       Tempest::Vec3 r1={u,v,0};
 
       view.project(r0.x,r0.y,r0.z);
@@ -340,6 +305,6 @@ Matrix4x4 Camera::view() const {
         distMd=md;
       }
 
-  view=mkView(distMd);
+  view=mkView(pos,distMd);
   return view;
   }
@@ -24,6 +24,9 @@ class Camera final {
       Magic
       };
 
+    // longer move in one simulation step is a teleport, not interpolated
+    static constexpr float MaxLerpDistance = 1000;
+
     void reset();
     void save(Serialize &s);
     void load(Serialize &s,Npc* pl);
@@ -43,15 +46,19 @@ class Camera final {
     void follow(const Npc& npc, uint64_t dt, bool inMove, bool includeRot);
 
     void setPosition(float x,float y,float z);
+    // view() is blended between position at beginStep and current one, with factor k
+    void beginStep();
+    void setInterpolation(float k);
     void setSpin(const Tempest::PointF& p);
     void setDistance(float d);
 
     Tempest::Matrix4x4 view() const;
-    Tempest::Matrix4x4 viewShadow(const std::array<float,3> &ldir,int layer) const;
 
   private:
     Gothic&               gothic;
     Tempest::Vec3         camPos={};
+    Tempest::Vec3         prevPos={};
+    float                 lerpK=1.f;
     bool                  isInMove=false;
     Tempest::Vec3         camBone={};
     Tempest::PointF       spin;
@@ -63,7 +70,8 @@ class Camera final {
 
     void implReset(const Npc& pl);
     void implMove(Tempest::KeyEvent::KeyType t);
-    Tempest::Matrix4x4 mkView(float dist) const;
+    Tempest::Matrix4x4 mkView(const Tempest::Vec3& pos, float dist) const;
+    Tempest::Vec3      viewPosition() const;
 
     const Daedalus::GEngineClasses::CCamSys& cameraDef() const;
     void clampZoom(float& z);
@@ -323,15 +323,17 @@ void Mixer::implMix(PatternInternal &pptn, float volume, int16_t *out, size_t cn
     const bool hasVol = hasVolumeCurves(pptn,i);
     if(hasVol) {
       volFromCurve(pptn,i,vol);
-      for(size_t r=0;r<cnt2;++r) {
-        float v = vol[r/2];
-        pcmMix[r] += pcm[r]*insVolume*(v*v);
+      for(size_t r=0;r<cnt;++r) {
+        const float v = vol[r]*vol[r]*insVolume;
+        pcmMix[r*2+0] += pcm[r*2+0]*v;
+        pcmMix[r*2+1] += pcm[r*2+1]*v;
         }
       } else {
-      for(size_t r=0;r<cnt2;++r) {
-        float v = i.volLast;
-        pcmMix[r] += pcm[r]*insVolume*(v*v);
-        }
+      const float v = i.volLast*i.volLast*insVolume;
+      float*       dst = pcmMix.data();
+      const float* src = pcm.data();
+      for(size_t r=0;r<cnt2;++r)
+        dst[r] += src[r]*v;
       }
     }
 
@@ -1,7 +1,9 @@
 #include "soundfont.h"
 
 #include <Tempest/Log>
+#include <atomic>
 #include <bitset>
+#include <mutex>
 
 #include "dlscollection.h"
 #include "hydra.h"
@@ -128,28 +130,71 @@ TSFDEF void __render_float(tsf* f, float* buffer, int samples, int flag_mixing)
 }
 #endif
 
+static std::atomic<uint64_t> decodeCount{0};
+static std::atomic<uint64_t> buildCount {0};
+
+// decoded samples of dls-collection; shared by all instruments and music themes, that use this collection
 struct SoundFont::Data {
+  enum { MaxIdle = 16 };
+
   Data(const DlsCollection &dls,const std::vector<Wave>& wave)
     :hydra(dls,wave) {
+    decodeCount.fetch_add(wave.size());
+    }
+
+  ~Data() {
+    for(auto i:idle)
+      Hydra::finalize(i);
+    }
+
+  tsf* acquire() {
+    {
+    std::lock_guard<std::mutex> guard(sync);
+    if(!idle.empty()) {
+      tsf* ret = idle.back();
+      idle.pop_back();
+      return ret;
+      }
+    }
+    buildCount.fetch_add(1);
+    return hydra.toTsf();
+    }
+
+  void release(tsf* f) {
+    if(!Hydra::hasNotes(f)) {
+      std::lock_guard<std::mutex> guard(sync);
+      if(idle.size()<MaxIdle) {
+        idle.push_back(f);
+        return;
+        }
+      }
+    Hydra::finalize(f);
     }
 
-  Dx8::Hydra hydra;
+  Dx8::Hydra        hydra;
+  std::mutex        sync;
+  std::vector<tsf*> idle;
+  };
+
+// tsf clones, where given note is free to use; avoids scan over all clones on each noteOn
+struct SoundFont::Pool {
+  std::vector<Instance*> free[256];
   };
 
-struct SoundFont::Instance {
-  Instance(std::shared_ptr<Data> &shData,uint32_t dwPatch){
+struct SoundFont::Instance : std::enable_shared_from_this<Instance> {
+  Instance(std::shared_ptr<Data> &shData,uint32_t dwPatch,std::shared_ptr<Pool>& pool):shData(shData),pool(pool){
     uint8_t bankHi = uint8_t((dwPatch & 0x00FF0000) >> 0x10);
     uint8_t bankLo = uint8_t((dwPatch & 0x0000FF00) >> 0x8);
     uint8_t patch  = uint8_t(dwPatch & 0x000000FF);
     int32_t bank   = (bankHi << 16) + bankLo;
 
-    fnt    = shData->hydra.toTsf();
+    fnt    = shData->acquire();
     preset = tsf_get_presetindex(fnt, bank, patch);
     tsf_set_output(fnt,TSF_STEREO_INTERLEAVED,44100,0);
     }
 
   ~Instance(){
-    Hydra::finalize(fnt);
+    shData->release(fnt);
     }
 
   bool hasNotes() {
@@ -175,17 +220,20 @@ struct SoundFont::Instance {
       return false;
     alloc[note]=false;
     tsf_note_off(fnt,preset,note);
+    pool->free[note].push_back(this);
     return true;
     }
 
-  std::bitset<256> alloc;
-  tsf*             fnt=nullptr;
-  int              preset=0;
+  std::shared_ptr<Data> shData;
+  std::shared_ptr<Pool> pool;
+  std::bitset<256>      alloc;
+  tsf*                  fnt=nullptr;
+  int                   preset=0;
   };
 
 struct SoundFont::Impl {
   Impl(std::shared_ptr<Data> &shData,uint32_t dwPatch)
-    :shData(shData), dwPatch(dwPatch) {
+    :shData(shData), dwPatch(dwPatch), pool(std::make_shared<Pool>()) {
     }
 
   ~Impl() {
@@ -198,13 +246,20 @@ struct SoundFont::Impl {
     }
 
   std::shared_ptr<Instance> noteOn(uint8_t note, uint8_t velosity){
-    for(auto& i:inst){
+    auto& free = pool->free[note];
+    while(!free.empty()) {
+      Instance* i = free.back();
+      free.pop_back();
       if(i->noteOn(note,velosity))
-        return i;
+        return i->shared_from_this();
       }
-    auto fnt = std::make_shared<Instance>(shData,dwPatch);
+
+    auto fnt = std::make_shared<Instance>(shData,dwPatch,pool);
     fnt->setPan(pan);
     fnt->noteOn(note,velosity);
+    for(size_t i=0;i<256;++i)
+      if(i!=note)
+        pool->free[i].push_back(fnt.get());
     inst.emplace_back(fnt);
     return inst.back();
     }
@@ -225,12 +280,16 @@ struct SoundFont::Impl {
     }
 
   void mix(float *samples, size_t count) {
-    for(auto& i:inst)
+    for(auto& i:inst) {
+      if(!i->hasNotes())
+        continue;
       tsf_render_float(i->fnt,samples,int(count),true);
+      }
     }
 
   std::shared_ptr<Data>                  shData;
   uint32_t                               dwPatch=0;
+  std::shared_ptr<Pool>                  pool;
   float                                  pan=0.5f;
   std::vector<std::shared_ptr<Instance>> inst;
   };
@@ -249,6 +308,14 @@ std::shared_ptr<SoundFont::Data> SoundFont::shared(const DlsCollection &dls,cons
   return std::shared_ptr<Data>(new Data(dls,wave));
   }
 
+uint64_t SoundFont::decodedWaves() {
+  return decodeCount.load();
+  }
+
+uint64_t SoundFont::builtPresets() {
+  return buildCount.load();
+  }
+
 bool SoundFont::hasNotes() const {
   if(impl==nullptr)
     return false;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -12,6 +13,7 @@ class SoundFont final {
   private:
     struct Impl;
     struct Instance;
+    struct Pool;
 
   public:
     enum  {
@@ -38,6 +40,9 @@ class SoundFont final {
     ~SoundFont();
 
     static std::shared_ptr<Data> shared(const DlsCollection& dls, const std::vector<Wave>& wave);
+    // totals over all collections: waves decoded to float pcm and tsf preset tables built
+    static uint64_t decodedWaves();
+    static uint64_t builtPresets();
 
     bool hasNotes() const;
     void setVolume(float v);
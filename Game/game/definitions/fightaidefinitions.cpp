@@ -1,20 +1,18 @@
 #include "fightaidefinitions.h"
 
-#include "gothic.h"
+#include <cstdio>
 
-FightAi::FightAi(Gothic& gothic) {
-  auto vm = gothic.createVm(u"Fight.dat");
-
-  auto& max = vm->getDATFile().getSymbolByName("MAX_FIGHTAI");
+FightAi::FightAi(Daedalus::DaedalusVM& vm) {
+  auto& max = vm.getDATFile().getSymbolByName("MAX_FIGHTAI");
   int count = max.getInt();
   if(count<0)
     count=0;
 
   fAi.resize(size_t(count));
   for(size_t i=1;i<fAi.size();++i)
-    fAi[i] = loadAi(*vm,i);
+    fAi[i] = loadAi(vm,i);
 
-  vm->clearReferences(Daedalus::IC_FightAi);
+  vm.clearReferences(Daedalus::IC_FightAi);
   }
 
 const FightAi::FA &FightAi::get(size_t i) {
@@ -24,12 +22,20 @@ const FightAi::FA &FightAi::get(size_t i) {
   return tmp;
   }
 
-Daedalus::GEngineClasses::C_FightAI FightAi::loadAi(Daedalus::DaedalusVM& vm,const char *name) {
-  Daedalus::GEngineClasses::C_FightAI ret={};
+FightAi::Queue FightAi::loadAi(Daedalus::DaedalusVM& vm,const char *name) {
+  Queue ret;
   auto id = vm.getDATFile().getSymbolIndexByName(name);
   if(id==size_t(-1))
     return ret;
-  vm.initializeInstance(ret, id, Daedalus::IC_FightAi);
+
+  Daedalus::GEngineClasses::C_FightAI fai={};
+  vm.initializeInstance(fai, id, Daedalus::IC_FightAi);
+  for(size_t i=0;i<Daedalus::GEngineClasses::MAX_MOVE;++i){
+    if(fai.move[i]==0)
+      break;
+    ret.move[ret.size] = fai.move[i];
+    ret.size++;
+    }
   return ret;
   }
 
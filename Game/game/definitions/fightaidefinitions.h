@@ -2,44 +2,48 @@
 
 #include <daedalus/DaedalusVM.h>
 
-class Gothic;
-
 class FightAi final {
   public:
+    // C_FightAI::move with trailing MOVE_NULL entries stripped at load time
+    struct Queue final {
+      Daedalus::GEngineClasses::Move move[Daedalus::GEngineClasses::MAX_MOVE]={};
+      uint32_t                       size=0;
+      };
+
     struct FA final {
-      Daedalus::GEngineClasses::C_FightAI enemy_prehit;      // Enemy attacks me
-      Daedalus::GEngineClasses::C_FightAI enemy_stormprehit; // Enemy makes a storm attack
-      Daedalus::GEngineClasses::C_FightAI my_w_combo;        // I'm in the combo window
-      Daedalus::GEngineClasses::C_FightAI my_w_runto;        // I run towards the opponent
-      Daedalus::GEngineClasses::C_FightAI my_w_strafe;       // Just take hit
-      Daedalus::GEngineClasses::C_FightAI my_w_focus;        // I have opponent in focus (can hit)
-      Daedalus::GEngineClasses::C_FightAI my_w_nofocus;      // I don't have opponent in focus
+      Queue enemy_prehit;        // Enemy attacks me
+      Queue enemy_stormprehit;   // Enemy makes a storm attack
+      Queue my_w_combo;          // I'm in the combo window
+      Queue my_w_runto;          // I run towards the opponent
+      Queue my_w_strafe;         // Just take hit
+      Queue my_w_focus;          // I have opponent in focus (can hit)
+      Queue my_w_nofocus;        // I don't have opponent in focus
 
       // 'G' - range
-      Daedalus::GEngineClasses::C_FightAI my_g_combo;        // I'm in the combo window (not used in G2)
-      Daedalus::GEngineClasses::C_FightAI my_g_runto;        // I run towards the opponent (can make a storm attack)
-      Daedalus::GEngineClasses::C_FightAI my_g_strafe;       // not used in G2
-      Daedalus::GEngineClasses::C_FightAI my_g_focus;        // I have opponent in focus (can hit)
+      Queue my_g_combo;          // I'm in the combo window (not used in G2)
+      Queue my_g_runto;          // I run towards the opponent (can make a storm attack)
+      Queue my_g_strafe;         // not used in G2
+      Queue my_g_focus;          // I have opponent in focus (can hit)
 
       // FK Range Foes (far away)
-      Daedalus::GEngineClasses::C_FightAI my_fk_focus;       // I have opponents in focus
+      Queue my_fk_focus;         // I have opponents in focus
 
-      Daedalus::GEngineClasses::C_FightAI my_g_fk_nofocus;   // I am NOT in focus of opponents (also applies to G-distance!)
+      Queue my_g_fk_nofocus;     // I am NOT in focus of opponents (also applies to G-distance!)
 
       // Range + Magic  (used at each removal)
-      Daedalus::GEngineClasses::C_FightAI my_fk_focus_far;   // Opponents in focus
-      Daedalus::GEngineClasses::C_FightAI my_fk_nofocus_far; // Opponents NOT in focus
+      Queue my_fk_focus_far;     // Opponents in focus
+      Queue my_fk_nofocus_far;   // Opponents NOT in focus
 
-      Daedalus::GEngineClasses::C_FightAI my_fk_focus_mag;   // Opponents in focus
-      Daedalus::GEngineClasses::C_FightAI my_fk_nofocus_mag; // Opponents NOT in focus
+      Queue my_fk_focus_mag;     // Opponents in focus
+      Queue my_fk_nofocus_mag;   // Opponents NOT in focus
       };
 
-    FightAi(Gothic &gothic);
+    FightAi(Daedalus::DaedalusVM &vm);
 
     const FA& get(size_t i);
 
   private:
-    auto loadAi(Daedalus::DaedalusVM &vm, const char* name) -> Daedalus::GEngineClasses::C_FightAI;
+    auto loadAi(Daedalus::DaedalusVM &vm, const char* name) -> Queue;
     FA   loadAi(Daedalus::DaedalusVM &vm, size_t id);
 
     std::vector<FA> fAi;
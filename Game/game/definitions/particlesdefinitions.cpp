@@ -3,6 +3,7 @@
 #include <Tempest/Log>
 
 #include "graphics/particlefx.h"
+#include "utils/workers.h"
 #include "gothic.h"
 
 using namespace Tempest;
@@ -22,11 +23,49 @@ const ParticleFx* ParticlesDefinitions::get(const char *name) {
   Daedalus::GEngineClasses::C_ParticleFX decl={};
   if(!implGet(name,decl))
     return nullptr;
+  if(prefetched) {
+    Log::d("particle system is not prefetched: \"",name,"\"");
+    ++late;
+    }
   std::unique_ptr<ParticleFx> p{new ParticleFx(decl)};
   auto ret = pfx.insert(std::make_pair<std::string,std::unique_ptr<ParticleFx>>(name,std::move(p)));
   return ret.first->second.get();
   }
 
+void ParticlesDefinitions::beginWarmup() {
+  prefetched = false;
+  late       = 0;
+  }
+
+void ParticlesDefinitions::prefetch(const std::vector<std::string>& names) {
+  struct Decl {
+    const std::string*                     name=nullptr;
+    Daedalus::GEngineClasses::C_ParticleFX decl={};
+    std::unique_ptr<ParticleFx>            fx;
+    };
+
+  // VM is single threaded - only textures and curves are decoded on workers
+  std::vector<Decl> decl;
+  decl.reserve(names.size());
+  for(auto& i:names) {
+    if(pfx.find(i)!=pfx.end())
+      continue;
+    decl.emplace_back();
+    decl.back().name = &i;
+    if(!implGet(i.c_str(),decl.back().decl))
+      decl.pop_back();
+    }
+
+  Workers::parallelFor(decl,[](Decl& d){
+    d.fx.reset(new ParticleFx(d.decl));
+    });
+
+  pfx.reserve(pfx.size()+decl.size());
+  for(auto& i:decl)
+    pfx.emplace(*i.name,std::move(i.fx));
+  prefetched = true;
+  }
+
 bool ParticlesDefinitions::implGet(const char *name,
                                    Daedalus::GEngineClasses::C_ParticleFX& ret) {
   if(!vm)
@@ -2,6 +2,8 @@
 
 #include <daedalus/DaedalusVM.h>
 #include <Tempest/Log>
+#include <cctype>
+#include <cstdio>
 
 using namespace Tempest;
 
@@ -17,6 +19,33 @@ SpellDefinitions::SpellDefinitions(Daedalus::DaedalusVM &vm) : vm(vm) {
     spl[count].instName = p.name;
     ++count;
     });
+
+  for(size_t i=0;i<spl.size();++i) {
+    std::string name = spl[i].instName;
+    for(auto& c:name)
+      c = char(std::toupper(c));
+    index.emplace(std::move(name),i);
+    }
+
+  auto& dat = vm.getDATFile();
+  if(dat.hasSymbolName("spellFxInstanceNames")) {
+    auto& names = dat.getSymbolByIndex(dat.getSymbolIndexByName("spellFxInstanceNames"));
+    const size_t count = names.properties.elemProps.count;
+    byId.resize(count);
+    cast.resize(count,size_t(-1));
+    vfx .resize(count);
+    for(size_t i=0;i<count;++i) {
+      const char* fx = names.getString(i).c_str();
+      byId[i] = implFind(fx);
+
+      char buf[256]={};
+      std::snprintf(buf,sizeof(buf),"Spell_Cast_%s",fx);
+      if(dat.hasSymbolName(buf))
+        cast[i] = dat.getSymbolIndexByName(buf);
+      std::snprintf(buf,sizeof(buf),"spellFX_%s",fx);
+      vfx[i] = buf;
+      }
+    }
   }
 
 SpellDefinitions::~SpellDefinitions() {
@@ -24,15 +53,41 @@ SpellDefinitions::~SpellDefinitions() {
   }
 
 const Daedalus::GEngineClasses::C_Spell &SpellDefinitions::find(const char* instanceName) const {
-  char format[64]={};
-  std::snprintf(format,sizeof(format),"SPELL_%s",instanceName);
-  for(auto& i:format)
-    i = char(std::toupper(i));
-
-  for(auto& i:spl)
-    if(i.instName==format)
-      return i;
+  if(auto s = implFind(instanceName))
+    return *s;
   Log::d("invalid spell [",instanceName,"]");
   static Daedalus::GEngineClasses::C_Spell szero={};
   return szero;
   }
+
+const Daedalus::GEngineClasses::C_Spell &SpellDefinitions::find(int32_t splId) const {
+  if(splId>=0 && size_t(splId)<byId.size() && byId[size_t(splId)]!=nullptr)
+    return *byId[size_t(splId)];
+  Log::d("invalid spell id [",splId,"]");
+  static Daedalus::GEngineClasses::C_Spell szero={};
+  return szero;
+  }
+
+size_t SpellDefinitions::castFunc(int32_t splId) const {
+  if(splId>=0 && size_t(splId)<cast.size())
+    return cast[size_t(splId)];
+  return size_t(-1);
+  }
+
+const char* SpellDefinitions::vfxName(int32_t splId) const {
+  if(splId>=0 && size_t(splId)<vfx.size())
+    return vfx[size_t(splId)].c_str();
+  return nullptr;
+  }
+
+const SpellDefinitions::Spell* SpellDefinitions::implFind(const char* instanceName) const {
+  std::string name = "SPELL_";
+  name += instanceName;
+  for(auto& c:name)
+    c = char(std::toupper(c));
+
+  auto it = index.find(name);
+  if(it==index.end())
+    return nullptr;
+  return &spl[it->second];
+  }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <daedalus/DaedalusStdlib.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class Gothic;
 
@@ -10,11 +13,23 @@ class SpellDefinitions final {
     ~SpellDefinitions();
 
     const Daedalus::GEngineClasses::C_Spell &find(const char* instanceName) const;
+    const Daedalus::GEngineClasses::C_Spell &find(int32_t splId) const;
+
+    size_t                          castFunc(int32_t splId) const;
+    const char*                     vfxName (int32_t splId) const;
+    const std::vector<std::string>& vfxNames() const { return vfx; }
 
   private:
     struct Spell:Daedalus::GEngineClasses::C_Spell {
       std::string instName;
       };
-    Daedalus::DaedalusVM& vm;
-    std::vector<Spell>    spl;
+
+    const Spell* implFind(const char* instanceName) const;
+
+    Daedalus::DaedalusVM&                  vm;
+    std::vector<Spell>                     spl;
+    std::unordered_map<std::string,size_t> index; // upper-case instance name -> spl
+    std::vector<const Spell*>              byId;  // spellFxInstanceNames order
+    std::vector<size_t>                    cast;  // Spell_Cast_<name>, by id
+    std::vector<std::string>               vfx;   // spellFX_<name>, by id
   };
@@ -1,8 +1,20 @@
 #include "svmdefinitions.h"
 
 #include <daedalus/DaedalusVM.h>
+#include <cctype>
+#include <cstring>
 
 SvmDefinitions::SvmDefinitions(Daedalus::DaedalusVM &vm):vm(vm) {
+  auto& sym = vm.getDATFile().getSymTable().symbols;
+  for(size_t i=0;i<sym.size();++i) {
+    auto& s = sym[i];
+    if(s.properties.elemProps.type!=Daedalus::EParType::EParType_String)
+      continue;
+    if(std::strncmp(s.name.c_str(),"C_SVM.",6)!=0)
+      continue;
+    memberId[s.name.substr(6)] = memberSym.size();
+    memberSym.push_back(i);
+    }
   }
 
 SvmDefinitions::~SvmDefinitions() {
@@ -10,27 +22,43 @@ SvmDefinitions::~SvmDefinitions() {
   }
 
 const Daedalus::ZString& SvmDefinitions::find(const char *speech, const int intId) {
-  if(speech!=nullptr && speech[0]=='$' && intId>=0){
-    const size_t id=size_t(intId);
+  static Daedalus::ZString empty;
+  if(speech==nullptr || speech[0]!='$' || intId<0)
+    return empty;
 
-    char name[128]={};
-    std::snprintf(name,sizeof(name),"SVM_%d",int(id));
+  std::string name = speech+1;
+  for(auto& c:name)
+    c = char(std::toupper(c));
 
-    if(svm.size()<=id)
-      svm.resize(id+1);
-    if(svm[id]==nullptr)
-      svm[id].reset(new Daedalus::GEngineClasses::C_SVM());
-    if(svm[id]->instanceSymbol==0){
-      size_t i = vm.getDATFile().getSymbolIndexByName(name);
-      vm.initializeInstance(*svm[id], i, Daedalus::IC_Svm);
-      }
+  auto it = memberId.find(name);
+  if(it==memberId.end())
+    return empty;
 
-    std::snprintf(name,sizeof(name),"C_SVM.%s",speech+1);
+  auto* v = voice(size_t(intId));
+  if(v==nullptr)
+    return empty;
+  return *v->text[it->second];
+  }
 
-    auto& i = vm.getDATFile().getSymbolByName(name); //TODO: optimize
-    return i.getString(0,svm[size_t(id)].get());
-    }
+SvmDefinitions::Voice* SvmDefinitions::voice(size_t id) {
+  if(id<voices.size() && voices[id].inst!=nullptr)
+    return &voices[id];
 
-  static Daedalus::ZString empty;
-  return empty;
+  char name[32]={};
+  std::snprintf(name,sizeof(name),"SVM_%d",int(id));
+  auto& dat = vm.getDATFile();
+  if(!dat.hasSymbolName(name))
+    return nullptr;
+
+  if(voices.size()<=id)
+    voices.resize(id+1);
+  auto& v = voices[id];
+  v.inst.reset(new Daedalus::GEngineClasses::C_SVM());
+  vm.initializeInstance(*v.inst, dat.getSymbolIndexByName(name), Daedalus::IC_Svm);
+
+  // resolve all lines of this voice once; strings are members of 'inst', so pointers stay valid
+  v.text.resize(memberSym.size());
+  for(size_t i=0;i<memberSym.size();++i)
+    v.text[i] = &dat.getSymbolByIndex(memberSym[i]).getString(0,v.inst.get());
+  return &v;
   }
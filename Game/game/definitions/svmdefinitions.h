@@ -3,6 +3,8 @@
 #include <daedalus/DaedalusStdlib.h>
 #include <daedalus/ZString.h>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 class Gothic;
 
@@ -14,7 +16,15 @@ class SvmDefinitions final {
     const Daedalus::ZString& find(const char* speech,const int id);
 
   private:
-    Daedalus::DaedalusVM&                                         vm;
-    std::vector<std::unique_ptr<Daedalus::GEngineClasses::C_SVM>> svm;
-  };
+    struct Voice final {
+      std::unique_ptr<Daedalus::GEngineClasses::C_SVM> inst;
+      std::vector<const Daedalus::ZString*>             text;
+      };
+
+    Voice* voice(size_t id);
 
+    Daedalus::DaedalusVM&                  vm;
+    std::vector<Voice>                     voices;
+    std::unordered_map<std::string,size_t> memberId;  // "$NAME" -> index in memberSym
+    std::vector<size_t>                    memberSym;
+  };
@@ -22,6 +22,10 @@ const VisualFx *VisualFxDefinitions::get(const char *name) {
   auto def = implGet(name);
   if(def==nullptr)
     return nullptr;
+  if(prefetched) {
+    Log::d("visual effect is not prefetched: \"",name,"\"");
+    ++late;
+    }
 
   static const char* keyName[int(SpellFxKey::Count)] = {
     "OPEN",
@@ -48,6 +52,22 @@ const VisualFx *VisualFxDefinitions::get(const char *name) {
   return ret.first->second.get();
   }
 
+void VisualFxDefinitions::beginWarmup() {
+  prefetched = false;
+  late       = 0;
+  }
+
+void VisualFxDefinitions::prefetch(const std::vector<std::string>& names, std::vector<std::string>& pfx) {
+  // VisualFx is a plain copy of script instance, so there is nothing to offload to workers
+  prefetched = false;
+  for(auto& i:names) {
+    auto fx = get(i.c_str());
+    if(fx!=nullptr && !fx->handle().visName_S.empty())
+      pfx.push_back(fx->handle().visName_S.c_str());
+    }
+  prefetched = true;
+  }
+
 Daedalus::GEngineClasses::CFx_Base *VisualFxDefinitions::implGet(const char *name) {
   static Daedalus::GEngineClasses::CFx_Base ret={};
   if(!vm)
@@ -3,6 +3,7 @@
 #include <daedalus/DaedalusStdlib.h>
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
 
 class Gothic;
@@ -14,10 +15,16 @@ class VisualFxDefinitions final {
     ~VisualFxDefinitions();
 
     const VisualFx *get(const char* name);
+    void            beginWarmup();
+    void            prefetch(const std::vector<std::string>& names, std::vector<std::string>& pfx);
+    // definitions created by 'get' after warmup of current world
+    size_t          lateLoads() const { return late; }
 
   private:
     std::unique_ptr<Daedalus::DaedalusVM>                     vm;
     std::unordered_map<std::string,std::unique_ptr<VisualFx>> vfx;
+    bool                                                      prefetched=false;
+    size_t                                                    late=0;
 
     Daedalus::GEngineClasses::CFx_Base *implGet(const char* name);
   };
@@ -36,7 +36,11 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
       return;
     }
 
-  if(tg.isPrehit() && isInGRange(npc,tg,owner)){
+  // ranges are used by most branches below, so evaluate them once per decision
+  const bool inGRange     = isInGRange    (npc,tg,owner);
+  const bool inAtackRange = isInAtackRange(npc,tg,owner);
+
+  if(tg.isPrehit() && inGRange){
     if(tg.bodyStateMasked()==BS_RUN)
       if(fillQueue(owner,ai.enemy_stormprehit))
         return;
@@ -45,7 +49,7 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
     }
 
   if(ws==WeaponState::Fist || ws==WeaponState::W1H || ws==WeaponState::W2H){
-    if(isInAtackRange(npc,tg,owner)) {
+    if(inAtackRange) {
       if(npc.bodyStateMasked()==BS_RUN)
         if(fillQueue(owner,ai.my_w_runto))
           return;
@@ -56,7 +60,7 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
         return;
       }
 
-    if(isInGRange(npc,tg,owner)) {
+    if(inGRange) {
       if(npc.bodyStateMasked()==BS_RUN)
         if(fillQueue(owner,ai.my_g_runto))
           return;
@@ -73,7 +77,7 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
     }
 
   if(ws==WeaponState::Bow || ws==WeaponState::CBow){
-    if(isInAtackRange(npc,tg,owner))
+    if(inAtackRange)
       if(fillQueue(owner,ai.my_fk_focus_far))
         return;
     if(fillQueue(owner,ai.my_fk_nofocus_far))
@@ -81,7 +85,7 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
     }
 
   if(ws==WeaponState::Mage){
-    if(isInAtackRange(npc,tg,owner))
+    if(inAtackRange)
       if(fillQueue(owner,ai.my_fk_focus_mag))
         return;
     if(fillQueue(owner,ai.my_fk_nofocus_mag))
@@ -91,16 +95,10 @@ void FightAlgo::fillQueue(Npc &npc, Npc &tg, GameScript& owner) {
   fillQueue(owner,ai.my_w_nofocus);
   }
 
-bool FightAlgo::fillQueue(GameScript& owner,const Daedalus::GEngineClasses::C_FightAI &src) {
-  uint32_t sz=0;
-  for(size_t i=0;i<Daedalus::GEngineClasses::MAX_MOVE;++i){
-    if(src.move[i]==0)
-      break;
-    sz++;
-    }
-  if(sz==0)
+bool FightAlgo::fillQueue(GameScript& owner,const FightAi::Queue &src) {
+  if(src.size==0)
     return false;
-  queueId = src.move[owner.rand(sz)];
+  queueId = src.move[owner.rand(src.size)];
   return queueId!=0;
   }
 
@@ -230,6 +228,10 @@ void FightAlgo::onTakeHit() {
     i = MV_NULL;
   }
 
+void FightAlgo::onEquipChanged() {
+  rangeCache = RangeCache();
+  }
+
 float FightAlgo::prefferedAtackDistance(const Npc &npc, const Npc &tg,  GameScript &owner) const {
   auto  gl     = tg.guild();
   float baseTg = float(owner.guildVal().fight_range_base[gl]);
@@ -270,37 +272,51 @@ bool FightAlgo::isInFocusAngle(const Npc &npc, const Npc &tg) const {
   return true;
   }
 
-float FightAlgo::gRange(GameScript &owner, const Npc &npc) {
+float FightAlgo::gRange(GameScript &owner, const Npc &npc) const {
   auto  gl = npc.guild();
   auto& gv = owner.guildVal();
   return float(gv.fight_range_g[gl]+gv.fight_range_base[gl])+weaponOnlyRange(owner,npc);
   }
 
-float FightAlgo::weaponRange(GameScript &owner, const Npc &npc) {
+float FightAlgo::weaponRange(GameScript &owner, const Npc &npc) const {
   auto  gl = npc.guild();
   auto& gv = owner.guildVal();
   return float(gv.fight_range_base[gl])+weaponOnlyRange(owner,npc);
   }
 
-float FightAlgo::weaponOnlyRange(GameScript &owner,const Npc &npc) {
+float FightAlgo::weaponOnlyRange(GameScript &owner,const Npc &npc) const {
   auto  gl  = npc.guild();
-  auto& gv  = owner.guildVal();
+  auto  ws  = npc.weaponState();
   auto  w   = npc.inventory().activeWeapon();
+
+  auto& c = rangeCache;
+  if(c.guild==gl && c.ws==ws && c.weapon==w)
+    return c.range;
+
+  auto& gv  = owner.guildVal();
   int   add = w ? w->swordLength() : 0;
 
-  switch(npc.weaponState()) {
+  c.guild  = gl;
+  c.ws     = ws;
+  c.weapon = w;
+  c.range  = 0;
+  switch(ws) {
     case WeaponState::W1H:
-      return float(gv.fight_range_1ha[gl] + add);
+      c.range = float(gv.fight_range_1ha[gl] + add);
+      break;
     case WeaponState::W2H:
-      return float(gv.fight_range_2ha[gl] + add);
+      c.range = float(gv.fight_range_2ha[gl] + add);
+      break;
     case WeaponState::NoWeapon:
     case WeaponState::Fist:
-      return float(gv.fight_range_fist[gl]);
+      c.range = float(gv.fight_range_fist[gl]);
+      break;
     case WeaponState::Bow:
     case WeaponState::CBow:
     case WeaponState::Mage:
-      return 3000;
+      c.range = 3000;
+      break;
     }
-  return 0;
+  return c.range;
   }
 
@@ -4,7 +4,11 @@
 
 #include <daedalus/DaedalusStdlib.h>
 
+#include "game/definitions/fightaidefinitions.h"
+#include "game/constants.h"
+
 class Npc;
+class Item;
 class GameScript;
 class Serialize;
 
@@ -37,6 +41,7 @@ class FightAlgo final {
     void   consumeAction();
     void   onClearTarget();
     void   onTakeHit();
+    void   onEquipChanged();
 
     bool   hasInstructions() const;
     bool   fetchInstructions(Npc &npc, Npc &tg, GameScript& owner);
@@ -50,13 +55,22 @@ class FightAlgo final {
 
   private:
     void   fillQueue(Npc &npc, Npc &tg, GameScript& owner);
-    bool   fillQueue(GameScript& owner,const Daedalus::GEngineClasses::C_FightAI& src);
+    bool   fillQueue(GameScript& owner,const FightAi::Queue& src);
+
+    float  gRange         (GameScript &owner,const Npc &npc) const;
+    float  weaponRange    (GameScript &owner,const Npc &npc) const;
+    float  weaponOnlyRange(GameScript &owner,const Npc &npc) const;
 
-    static float  gRange         (GameScript &owner,const Npc &npc);
-    static float  weaponRange    (GameScript &owner,const Npc &npc);
-    static float  weaponOnlyRange(GameScript &owner,const Npc &npc);
+    // weapon range depends only on guild, weapon state and equipped weapon; recomputed when any of them changes
+    struct RangeCache final {
+      uint32_t    guild  = uint32_t(-1);
+      WeaponState ws     = WeaponState::NoWeapon;
+      const Item* weapon = nullptr;
+      float       range  = 0;
+      };
 
     Daedalus::GEngineClasses::Move queueId=Daedalus::GEngineClasses::Move(0);
     Action                         tr   [MV_MAX]={};
     bool                           hitFlg=false;
+    mutable RangeCache             rangeCache;
   };
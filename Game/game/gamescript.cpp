@@ -2,18 +2,23 @@
 
 #include "game/definitions/spelldefinitions.h"
 #include "game/serialize.h"
+#include "game/scriptprofiler.h"
 #include "graphics/visualfx.h"
 #include "gothic.h"
 #include "world/npc.h"
 #include "world/item.h"
 
+#include <algorithm>
 #include <fstream>
+#include <cstring>
 #include <Tempest/Log>
 #include <Tempest/SoundEffect>
 
 using namespace Tempest;
 using namespace Daedalus::GameState;
 
+uint32_t GameScript::randSeed = std::mt19937::default_seed;
+
 struct GameScript::ScopeVar final {
   ScopeVar(Daedalus::DaedalusVM& vm,Daedalus::PARSymbol& sym,Npc& n)
     :ScopeVar(vm,sym,n.handle(),Daedalus::IC_Npc){
@@ -61,9 +66,11 @@ bool GameScript::GlobalOutput::isFinished() {
   }
 
 GameScript::GameScript(GameSession &owner)
-  :vm(owner.loadScriptCode()),owner(owner){
+  :vm(owner.loadScriptCode()),owner(owner),randGen(randSeed){
   Daedalus::registerGothicEngineClasses(vm);
   aiDefaultPipe.reset(new GlobalOutput(*this));
+  if(owner.isScriptProfile())
+    profiler.reset(new ScriptProfiler(owner.scriptTraceFile(),owner.scriptTraceEvents()));
   initCommon();
   }
 
@@ -75,7 +82,7 @@ GameScript::GameScript(GameSession &owner, Serialize &fin)
   for(size_t i=0;i<sz;++i){
     uint32_t f=0,s=0;
     fin.read(f,s);
-    dlgKnownInfos.insert(std::make_pair(f,s));
+    dlgKnownInfos.insert(knownInfoKey(f,s));
     }
 
   fin.read(gilAttitudes);
@@ -83,255 +90,274 @@ GameScript::GameScript(GameSession &owner, Serialize &fin)
 
 GameScript::~GameScript() {
   vm.clearReferences(Daedalus::IC_Info);
+  if(profiler!=nullptr) {
+    profiler->report();
+    profiler->writeTrace();
+    }
+  }
+
+void GameScript::bindExternal(const char* name, std::function<void(Daedalus::DaedalusVM&)> fn) {
+  auto& dat = vm.getDATFile();
+  if(profiler==nullptr || !dat.hasSymbolName(name)) {
+    vm.registerExternalFunction(name,fn);
+    return;
+    }
+  auto* prof = profiler.get();
+  auto  id   = dat.getSymbolIndexByName(name);
+  vm.registerExternalFunction(name,[prof,id,name,fn](Daedalus::DaedalusVM& vm){
+    ScriptProfiler::Scope scope(prof,id,name);
+    fn(vm);
+    });
   }
 
 void GameScript::initCommon() {
   vm.registerUnsatisfiedLink([this](Daedalus::DaedalusVM& vm){return notImplementedRoutine(vm);});
 
-  vm.registerExternalFunction("concatstrings", &GameScript::concatstrings);
-  vm.registerExternalFunction("inttostring",   &GameScript::inttostring  );
-  vm.registerExternalFunction("floattostring", &GameScript::floattostring);
-  vm.registerExternalFunction("inttofloat",    &GameScript::inttofloat   );
-  vm.registerExternalFunction("floattoint",    &GameScript::floattoint   );
-
-  vm.registerExternalFunction("hlp_random",          [this](Daedalus::DaedalusVM& vm){ hlp_random(vm);         });
-  vm.registerExternalFunction("hlp_strcmp",          &GameScript::hlp_strcmp                                   );
-  vm.registerExternalFunction("hlp_isvalidnpc",      [this](Daedalus::DaedalusVM& vm){ hlp_isvalidnpc(vm);     });
-  vm.registerExternalFunction("hlp_isvaliditem",     [this](Daedalus::DaedalusVM& vm){ hlp_isvaliditem(vm);    });
-  vm.registerExternalFunction("hlp_isitem",          [this](Daedalus::DaedalusVM& vm){ hlp_isitem(vm);         });
-  vm.registerExternalFunction("hlp_getnpc",          [this](Daedalus::DaedalusVM& vm){ hlp_getnpc(vm);         });
-  vm.registerExternalFunction("hlp_getinstanceid",   [this](Daedalus::DaedalusVM& vm){ hlp_getinstanceid(vm);  });
-
-  vm.registerExternalFunction("wld_insertnpc",       [this](Daedalus::DaedalusVM& vm){ wld_insertnpc(vm);  });
-  vm.registerExternalFunction("wld_insertitem",      [this](Daedalus::DaedalusVM& vm){ wld_insertitem(vm); });
-  vm.registerExternalFunction("wld_settime",         [this](Daedalus::DaedalusVM& vm){ wld_settime(vm);    });
-  vm.registerExternalFunction("wld_getday",          [this](Daedalus::DaedalusVM& vm){ wld_getday(vm);     });
-  vm.registerExternalFunction("wld_playeffect",      [this](Daedalus::DaedalusVM& vm){ wld_playeffect(vm); });
-  vm.registerExternalFunction("wld_stopeffect",      [this](Daedalus::DaedalusVM& vm){ wld_stopeffect(vm); });
-  vm.registerExternalFunction("wld_getplayerportalguild",
-                                                     [this](Daedalus::DaedalusVM& vm){ wld_getplayerportalguild(vm); });
-  vm.registerExternalFunction("wld_setguildattitude",[this](Daedalus::DaedalusVM& vm){ wld_setguildattitude(vm);     });
-  vm.registerExternalFunction("wld_getguildattitude",[this](Daedalus::DaedalusVM& vm){ wld_getguildattitude(vm);     });
-  vm.registerExternalFunction("wld_istime",          [this](Daedalus::DaedalusVM& vm){ wld_istime(vm);               });
-  vm.registerExternalFunction("wld_isfpavailable",   [this](Daedalus::DaedalusVM& vm){ wld_isfpavailable(vm);        });
-  vm.registerExternalFunction("wld_isnextfpavailable",
-                                                     [this](Daedalus::DaedalusVM& vm){ wld_isnextfpavailable(vm);    });
-  vm.registerExternalFunction("wld_ismobavailable",  [this](Daedalus::DaedalusVM& vm){ wld_ismobavailable(vm);       });
-  vm.registerExternalFunction("wld_setmobroutine",   [this](Daedalus::DaedalusVM& vm){ wld_setmobroutine(vm);        });
-  vm.registerExternalFunction("wld_getmobstate",     [this](Daedalus::DaedalusVM& vm){ wld_getmobstate(vm);          });
-  vm.registerExternalFunction("wld_assignroomtoguild",
-                                                     [this](Daedalus::DaedalusVM& vm){ wld_assignroomtoguild(vm);    });
-  vm.registerExternalFunction("wld_detectnpc",       [this](Daedalus::DaedalusVM& vm){ wld_detectnpc(vm);            });
-  vm.registerExternalFunction("wld_detectnpcex",     [this](Daedalus::DaedalusVM& vm){ wld_detectnpcex(vm);          });
-  vm.registerExternalFunction("wld_detectitem",      [this](Daedalus::DaedalusVM& vm){ wld_detectitem(vm);           });
-
-  vm.registerExternalFunction("mdl_setvisual",       [this](Daedalus::DaedalusVM& vm){ mdl_setvisual(vm);        });
-  vm.registerExternalFunction("mdl_setvisualbody",   [this](Daedalus::DaedalusVM& vm){ mdl_setvisualbody(vm);    });
-  vm.registerExternalFunction("mdl_setmodelfatness", [this](Daedalus::DaedalusVM& vm){ mdl_setmodelfatness(vm);  });
-  vm.registerExternalFunction("mdl_applyoverlaymds", [this](Daedalus::DaedalusVM& vm){ mdl_applyoverlaymds(vm);  });
-  vm.registerExternalFunction("mdl_applyoverlaymdstimed",
-                                                     [this](Daedalus::DaedalusVM& vm){ mdl_applyoverlaymdstimed(vm); });
-  vm.registerExternalFunction("mdl_removeoverlaymds",[this](Daedalus::DaedalusVM& vm){ mdl_removeoverlaymds(vm); });
-  vm.registerExternalFunction("mdl_setmodelscale",   [this](Daedalus::DaedalusVM& vm){ mdl_setmodelscale(vm);    });
-  vm.registerExternalFunction("mdl_startfaceani",    [this](Daedalus::DaedalusVM& vm){ mdl_startfaceani(vm);     });
-  vm.registerExternalFunction("mdl_applyrandomani",  [this](Daedalus::DaedalusVM& vm){ mdl_applyrandomani(vm);   });
-  vm.registerExternalFunction("mdl_applyrandomanifreq",
-                                                     [this](Daedalus::DaedalusVM& vm){ mdl_applyrandomanifreq(vm);});
-
-  vm.registerExternalFunction("npc_settofightmode",  [this](Daedalus::DaedalusVM& vm){ npc_settofightmode(vm);   });
-  vm.registerExternalFunction("npc_settofistmode",   [this](Daedalus::DaedalusVM& vm){ npc_settofistmode(vm);    });
-  vm.registerExternalFunction("npc_isinstate",       [this](Daedalus::DaedalusVM& vm){ npc_isinstate(vm);        });
-  vm.registerExternalFunction("npc_wasinstate",      [this](Daedalus::DaedalusVM& vm){ npc_wasinstate(vm);       });
-  vm.registerExternalFunction("npc_getdisttowp",     [this](Daedalus::DaedalusVM& vm){ npc_getdisttowp(vm);      });
-  vm.registerExternalFunction("npc_exchangeroutine", [this](Daedalus::DaedalusVM& vm){ npc_exchangeroutine(vm);  });
-  vm.registerExternalFunction("npc_isdead",          [this](Daedalus::DaedalusVM& vm){ npc_isdead(vm);           });
-  vm.registerExternalFunction("npc_knowsinfo",       [this](Daedalus::DaedalusVM& vm){ npc_knowsinfo(vm);        });
-  vm.registerExternalFunction("npc_settalentskill",  [this](Daedalus::DaedalusVM& vm){ npc_settalentskill(vm);   });
-  vm.registerExternalFunction("npc_gettalentskill",  [this](Daedalus::DaedalusVM& vm){ npc_gettalentskill(vm);   });
-  vm.registerExternalFunction("npc_settalentvalue",  [this](Daedalus::DaedalusVM& vm){ npc_settalentvalue(vm);   });
-  vm.registerExternalFunction("npc_gettalentvalue",  [this](Daedalus::DaedalusVM& vm){ npc_gettalentvalue(vm);   });
-  vm.registerExternalFunction("npc_setrefusetalk",   [this](Daedalus::DaedalusVM& vm){ npc_setrefusetalk(vm);    });
-  vm.registerExternalFunction("npc_refusetalk",      [this](Daedalus::DaedalusVM& vm){ npc_refusetalk(vm);       });
-  vm.registerExternalFunction("npc_hasitems",        [this](Daedalus::DaedalusVM& vm){ npc_hasitems(vm);         });
-  vm.registerExternalFunction("npc_getinvitem",      [this](Daedalus::DaedalusVM& vm){ npc_getinvitem(vm);       });
-  vm.registerExternalFunction("npc_removeinvitem",   [this](Daedalus::DaedalusVM& vm){ npc_removeinvitem(vm);    });
-  vm.registerExternalFunction("npc_removeinvitems",  [this](Daedalus::DaedalusVM& vm){ npc_removeinvitems(vm);   });
-  vm.registerExternalFunction("npc_getbodystate",    [this](Daedalus::DaedalusVM& vm){ npc_getbodystate(vm);     });
-  vm.registerExternalFunction("npc_getlookattarget", [this](Daedalus::DaedalusVM& vm){ npc_getlookattarget(vm);  });
-  vm.registerExternalFunction("npc_getdisttonpc",    [this](Daedalus::DaedalusVM& vm){ npc_getdisttonpc(vm);     });
-  vm.registerExternalFunction("npc_hasequippedarmor",[this](Daedalus::DaedalusVM& vm){ npc_hasequippedarmor(vm); });
-  vm.registerExternalFunction("npc_setperctime",     [this](Daedalus::DaedalusVM& vm){ npc_setperctime(vm);      });
-  vm.registerExternalFunction("npc_percenable",      [this](Daedalus::DaedalusVM& vm){ npc_percenable(vm);       });
-  vm.registerExternalFunction("npc_percdisable",     [this](Daedalus::DaedalusVM& vm){ npc_percdisable(vm);      });
-  vm.registerExternalFunction("npc_getnearestwp",    [this](Daedalus::DaedalusVM& vm){ npc_getnearestwp(vm);     });
-  vm.registerExternalFunction("npc_clearaiqueue",    [this](Daedalus::DaedalusVM& vm){ npc_clearaiqueue(vm);     });
-  vm.registerExternalFunction("npc_isplayer",        [this](Daedalus::DaedalusVM& vm){ npc_isplayer(vm);         });
-  vm.registerExternalFunction("npc_getstatetime",    [this](Daedalus::DaedalusVM& vm){ npc_getstatetime(vm);     });
-  vm.registerExternalFunction("npc_setstatetime",    [this](Daedalus::DaedalusVM& vm){ npc_setstatetime(vm);     });
-  vm.registerExternalFunction("npc_changeattribute", [this](Daedalus::DaedalusVM& vm){ npc_changeattribute(vm);  });
-  vm.registerExternalFunction("npc_isonfp",          [this](Daedalus::DaedalusVM& vm){ npc_isonfp(vm);           });
-  vm.registerExternalFunction("npc_getheighttonpc",  [this](Daedalus::DaedalusVM& vm){ npc_getheighttonpc(vm);   });
-  vm.registerExternalFunction("npc_getequippedmeleeweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getequippedmeleeweapon(vm); });
-  vm.registerExternalFunction("npc_getequippedrangedweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getequippedrangedweapon(vm); });
-  vm.registerExternalFunction("npc_getequippedarmor",[this](Daedalus::DaedalusVM& vm){ npc_getequippedarmor(vm); });
-  vm.registerExternalFunction("npc_canseenpc",       [this](Daedalus::DaedalusVM& vm){ npc_canseenpc(vm);        });
-  vm.registerExternalFunction("npc_hasequippedweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_hasequippedweapon(vm); });
-  vm.registerExternalFunction("npc_hasequippedmeleeweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_hasequippedmeleeweapon(vm); });
-  vm.registerExternalFunction("npc_hasequippedrangedweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_hasequippedrangedweapon(vm); });
-  vm.registerExternalFunction("npc_getactivespell",  [this](Daedalus::DaedalusVM& vm){ npc_getactivespell(vm);   });
-  vm.registerExternalFunction("npc_getactivespellisscroll",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getactivespellisscroll(vm); });
-  vm.registerExternalFunction("npc_getactivespellcat",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getactivespellcat(vm); });
-  vm.registerExternalFunction("npc_setactivespellinfo",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_setactivespellinfo(vm); });
-
-  vm.registerExternalFunction("npc_canseenpcfreelos",[this](Daedalus::DaedalusVM& vm){ npc_canseenpcfreelos(vm); });
-  vm.registerExternalFunction("npc_isinfightmode",   [this](Daedalus::DaedalusVM& vm){ npc_isinfightmode(vm);    });
-  vm.registerExternalFunction("npc_settarget",       [this](Daedalus::DaedalusVM& vm){ npc_settarget(vm);        });
-  vm.registerExternalFunction("npc_gettarget",       [this](Daedalus::DaedalusVM& vm){ npc_gettarget(vm);        });
-  vm.registerExternalFunction("npc_getnexttarget",   [this](Daedalus::DaedalusVM& vm){ npc_getnexttarget(vm);    });
-  vm.registerExternalFunction("npc_sendpassiveperc", [this](Daedalus::DaedalusVM& vm){ npc_sendpassiveperc(vm);  });
-  vm.registerExternalFunction("npc_checkinfo",       [this](Daedalus::DaedalusVM& vm){ npc_checkinfo(vm);        });
-  vm.registerExternalFunction("npc_getportalguild",  [this](Daedalus::DaedalusVM& vm){ npc_getportalguild(vm);   });
-  vm.registerExternalFunction("npc_isinplayersroom", [this](Daedalus::DaedalusVM& vm){ npc_isinplayersroom(vm);  });
-  vm.registerExternalFunction("npc_getreadiedweapon",[this](Daedalus::DaedalusVM& vm){ npc_getreadiedweapon(vm); });
-  vm.registerExternalFunction("npc_hasreadiedmeleeweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_hasreadiedmeleeweapon(vm); });
-  vm.registerExternalFunction("npc_isdrawingspell",  [this](Daedalus::DaedalusVM& vm){ npc_isdrawingspell(vm);   });
-  vm.registerExternalFunction("npc_isdrawingweapon", [this](Daedalus::DaedalusVM& vm){ npc_isdrawingweapon(vm);  });
-  vm.registerExternalFunction("npc_perceiveall",     [this](Daedalus::DaedalusVM& vm){ npc_perceiveall(vm);      });
-  vm.registerExternalFunction("npc_stopani",         [this](Daedalus::DaedalusVM& vm){ npc_stopani(vm);          });
-  vm.registerExternalFunction("npc_settrueguild",    [this](Daedalus::DaedalusVM& vm){ npc_settrueguild(vm);     });
-  vm.registerExternalFunction("npc_gettrueguild",    [this](Daedalus::DaedalusVM& vm){ npc_gettrueguild(vm);     });
-  vm.registerExternalFunction("npc_clearinventory",  [this](Daedalus::DaedalusVM& vm){ npc_clearinventory(vm);   });
-  vm.registerExternalFunction("npc_getattitude",     [this](Daedalus::DaedalusVM& vm){ npc_getattitude(vm);      });
-  vm.registerExternalFunction("npc_getpermattitude", [this](Daedalus::DaedalusVM& vm){ npc_getpermattitude(vm);  });
-  vm.registerExternalFunction("npc_setattitude",     [this](Daedalus::DaedalusVM& vm){ npc_setattitude(vm);      });
-  vm.registerExternalFunction("npc_settempattitude", [this](Daedalus::DaedalusVM& vm){ npc_settempattitude(vm);  });
-  vm.registerExternalFunction("npc_hasbodyflag",     [this](Daedalus::DaedalusVM& vm){ npc_hasbodyflag(vm);      });
-  vm.registerExternalFunction("npc_getlasthitspellid",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getlasthitspellid(vm);});
-  vm.registerExternalFunction("npc_getlasthitspellcat",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_getlasthitspellcat(vm);});
-  vm.registerExternalFunction("npc_playani",         [this](Daedalus::DaedalusVM& vm){ npc_playani(vm);          });
-
-  vm.registerExternalFunction("npc_isdetectedmobownedbynpc",
-                                                     [this](Daedalus::DaedalusVM& vm){ npc_isdetectedmobownedbynpc(vm);});
-  vm.registerExternalFunction("npc_getdetectedmob",  [this](Daedalus::DaedalusVM& vm){ npc_getdetectedmob(vm);   });
-  vm.registerExternalFunction("npc_ownedbynpc",      [this](Daedalus::DaedalusVM& vm){ npc_ownedbynpc(vm);       });
-
-  vm.registerExternalFunction("ai_output",           [this](Daedalus::DaedalusVM& vm){ ai_output(vm);            });
-  vm.registerExternalFunction("ai_stopprocessinfos", [this](Daedalus::DaedalusVM& vm){ ai_stopprocessinfos(vm);  });
-  vm.registerExternalFunction("ai_processinfos",     [this](Daedalus::DaedalusVM& vm){ ai_processinfos(vm);      });
-  vm.registerExternalFunction("ai_standup",          [this](Daedalus::DaedalusVM& vm){ ai_standup(vm);           });
-  vm.registerExternalFunction("ai_standupquick",     [this](Daedalus::DaedalusVM& vm){ ai_standupquick(vm);      });
-  vm.registerExternalFunction("ai_continueroutine",  [this](Daedalus::DaedalusVM& vm){ ai_continueroutine(vm);   });
-  vm.registerExternalFunction("ai_printscreen",      [this](Daedalus::DaedalusVM& vm){ printscreen(vm);          });
-  vm.registerExternalFunction("ai_stoplookat",       [this](Daedalus::DaedalusVM& vm){ ai_stoplookat(vm);        });
-  vm.registerExternalFunction("ai_lookatnpc",        [this](Daedalus::DaedalusVM& vm){ ai_lookatnpc(vm);         });
-  vm.registerExternalFunction("ai_removeweapon",     [this](Daedalus::DaedalusVM& vm){ ai_removeweapon(vm);      });
-  vm.registerExternalFunction("ai_turntonpc",        [this](Daedalus::DaedalusVM& vm){ ai_turntonpc(vm);         });
-  vm.registerExternalFunction("ai_outputsvm",        [this](Daedalus::DaedalusVM& vm){ ai_outputsvm(vm);         });
-  vm.registerExternalFunction("ai_outputsvm_overlay",[this](Daedalus::DaedalusVM& vm){ ai_outputsvm_overlay(vm); });
-  vm.registerExternalFunction("ai_startstate",       [this](Daedalus::DaedalusVM& vm){ ai_startstate(vm);        });
-  vm.registerExternalFunction("ai_playani",          [this](Daedalus::DaedalusVM& vm){ ai_playani(vm);           });
-  vm.registerExternalFunction("ai_setwalkmode",      [this](Daedalus::DaedalusVM& vm){ ai_setwalkmode(vm);       });
-  vm.registerExternalFunction("ai_wait",             [this](Daedalus::DaedalusVM& vm){ ai_wait(vm);              });
-  vm.registerExternalFunction("ai_waitms",           [this](Daedalus::DaedalusVM& vm){ ai_waitms(vm);            });
-  vm.registerExternalFunction("ai_aligntowp",        [this](Daedalus::DaedalusVM& vm){ ai_aligntowp(vm);         });
-  vm.registerExternalFunction("ai_gotowp",           [this](Daedalus::DaedalusVM& vm){ ai_gotowp(vm);            });
-  vm.registerExternalFunction("ai_gotofp",           [this](Daedalus::DaedalusVM& vm){ ai_gotofp(vm);            });
-  vm.registerExternalFunction("ai_playanibs",        [this](Daedalus::DaedalusVM& vm){ ai_playanibs(vm);         });
-  vm.registerExternalFunction("ai_equiparmor",       [this](Daedalus::DaedalusVM& vm){ ai_equiparmor(vm);        });
-  vm.registerExternalFunction("ai_equipbestarmor",   [this](Daedalus::DaedalusVM& vm){ ai_equipbestarmor(vm);    });
-  vm.registerExternalFunction("ai_equipbestmeleeweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ ai_equipbestmeleeweapon(vm);  });
-  vm.registerExternalFunction("ai_equipbestrangedweapon",
-                                                     [this](Daedalus::DaedalusVM& vm){ ai_equipbestrangedweapon(vm); });
-  vm.registerExternalFunction("ai_usemob",           [this](Daedalus::DaedalusVM& vm){ ai_usemob(vm);            });
-  vm.registerExternalFunction("ai_teleport",         [this](Daedalus::DaedalusVM& vm){ ai_teleport(vm);          });
-  vm.registerExternalFunction("ai_stoppointat",      [this](Daedalus::DaedalusVM& vm){ ai_stoppointat(vm);       });
-  vm.registerExternalFunction("ai_drawweapon",       [this](Daedalus::DaedalusVM& vm){ ai_drawweapon(vm);  });
-  vm.registerExternalFunction("ai_readymeleeweapon", [this](Daedalus::DaedalusVM& vm){ ai_readymeleeweapon(vm);  });
-  vm.registerExternalFunction("ai_readyrangedweapon",[this](Daedalus::DaedalusVM& vm){ ai_readyrangedweapon(vm); });
-  vm.registerExternalFunction("ai_readyspell",       [this](Daedalus::DaedalusVM& vm){ ai_readyspell(vm);        });
-  vm.registerExternalFunction("ai_attack",           [this](Daedalus::DaedalusVM& vm){ ai_atack(vm);             });
-  vm.registerExternalFunction("ai_flee",             [this](Daedalus::DaedalusVM& vm){ ai_flee(vm);              });
-  vm.registerExternalFunction("ai_dodge",            [this](Daedalus::DaedalusVM& vm){ ai_dodge(vm);             });
-  vm.registerExternalFunction("ai_unequipweapons",   [this](Daedalus::DaedalusVM& vm){ ai_unequipweapons(vm);    });
-  vm.registerExternalFunction("ai_unequiparmor",     [this](Daedalus::DaedalusVM& vm){ ai_unequiparmor(vm);      });
-  vm.registerExternalFunction("ai_gotonpc",          [this](Daedalus::DaedalusVM& vm){ ai_gotonpc(vm);           });
-  vm.registerExternalFunction("ai_gotonextfp",       [this](Daedalus::DaedalusVM& vm){ ai_gotonextfp(vm);        });
-  vm.registerExternalFunction("ai_aligntofp",        [this](Daedalus::DaedalusVM& vm){ ai_aligntofp(vm);         });
-  vm.registerExternalFunction("ai_useitem",          [this](Daedalus::DaedalusVM& vm){ ai_useitem(vm);           });
-  vm.registerExternalFunction("ai_useitemtostate",   [this](Daedalus::DaedalusVM& vm){ ai_useitemtostate(vm);    });
-  vm.registerExternalFunction("ai_setnpcstostate",   [this](Daedalus::DaedalusVM& vm){ ai_setnpcstostate(vm);    });
-  vm.registerExternalFunction("ai_finishingmove",    [this](Daedalus::DaedalusVM& vm){ ai_finishingmove(vm);     });
-
-  vm.registerExternalFunction("mob_hasitems",        [this](Daedalus::DaedalusVM& vm){ mob_hasitems(vm);         });
-
-  vm.registerExternalFunction("ta_min",              [this](Daedalus::DaedalusVM& vm){ ta_min(vm);               });
-
-  vm.registerExternalFunction("log_createtopic",     [this](Daedalus::DaedalusVM& vm){ log_createtopic(vm);      });
-  vm.registerExternalFunction("log_settopicstatus",  [this](Daedalus::DaedalusVM& vm){ log_settopicstatus(vm);   });
-  vm.registerExternalFunction("log_addentry",        [this](Daedalus::DaedalusVM& vm){ log_addentry(vm);         });
-
-  vm.registerExternalFunction("equipitem",           [this](Daedalus::DaedalusVM& vm){ equipitem(vm);            });
-  vm.registerExternalFunction("createinvitem",       [this](Daedalus::DaedalusVM& vm){ createinvitem(vm);        });
-  vm.registerExternalFunction("createinvitems",      [this](Daedalus::DaedalusVM& vm){ createinvitems(vm);       });
-
-  vm.registerExternalFunction("info_addchoice",      [this](Daedalus::DaedalusVM& vm){ info_addchoice(vm);       });
-  vm.registerExternalFunction("info_clearchoices",   [this](Daedalus::DaedalusVM& vm){ info_clearchoices(vm);    });
-  vm.registerExternalFunction("infomanager_hasfinished",
-                                                     [this](Daedalus::DaedalusVM& vm){ infomanager_hasfinished(vm); });
-
-  vm.registerExternalFunction("snd_play",            [this](Daedalus::DaedalusVM& vm){ snd_play(vm);             });
-
-  vm.registerExternalFunction("doc_create",          [this](Daedalus::DaedalusVM& vm){ doc_create(vm);           });
-  vm.registerExternalFunction("doc_createmap",       [this](Daedalus::DaedalusVM& vm){ doc_createmap(vm);        });
-  vm.registerExternalFunction("doc_setpage",         [this](Daedalus::DaedalusVM& vm){ doc_setpage(vm);          });
-  vm.registerExternalFunction("doc_setpages",        [this](Daedalus::DaedalusVM& vm){ doc_setpages(vm);         });
-  vm.registerExternalFunction("doc_setmargins",      [this](Daedalus::DaedalusVM& vm){ doc_setmargins(vm);       });
-  vm.registerExternalFunction("doc_printline",       [this](Daedalus::DaedalusVM& vm){ doc_printline(vm);        });
-  vm.registerExternalFunction("doc_printlines",      [this](Daedalus::DaedalusVM& vm){ doc_printlines(vm);       });
-  vm.registerExternalFunction("doc_setfont",         [this](Daedalus::DaedalusVM& vm){ doc_setfont(vm);          });
-  vm.registerExternalFunction("doc_setlevel",        [this](Daedalus::DaedalusVM& vm){ doc_setlevel(vm);         });
-  vm.registerExternalFunction("doc_setlevelcoords",  [this](Daedalus::DaedalusVM& vm){ doc_setlevelcoords(vm);   });
-  vm.registerExternalFunction("doc_show",            [this](Daedalus::DaedalusVM& vm){ doc_show(vm);             });
-
-  vm.registerExternalFunction("introducechapter",    [this](Daedalus::DaedalusVM& vm){ introducechapter(vm);     });
-  vm.registerExternalFunction("playvideo",           [this](Daedalus::DaedalusVM& vm){ playvideo(vm);            });
-  vm.registerExternalFunction("playvideoex",         [this](Daedalus::DaedalusVM& vm){ playvideoex(vm);          });
-  vm.registerExternalFunction("printscreen",         [this](Daedalus::DaedalusVM& vm){ printscreen(vm);          });
-  vm.registerExternalFunction("printdialog",         [this](Daedalus::DaedalusVM& vm){ printdialog(vm);          });
-  vm.registerExternalFunction("print",               [this](Daedalus::DaedalusVM& vm){ print(vm);                });
-  vm.registerExternalFunction("perc_setrange",       [this](Daedalus::DaedalusVM& vm){ perc_setrange(vm);        });
-
-  vm.registerExternalFunction("printdebug",          [this](Daedalus::DaedalusVM& vm){ printdebug(vm);           });
-  vm.registerExternalFunction("printdebugch",        [this](Daedalus::DaedalusVM& vm){ printdebugch(vm);         });
-  vm.registerExternalFunction("printdebuginst",      [this](Daedalus::DaedalusVM& vm){ printdebuginst(vm);       });
-  vm.registerExternalFunction("printdebuginstch",    [this](Daedalus::DaedalusVM& vm){ printdebuginstch(vm);     });
-
-  vm.registerExternalFunction("game_initgerman",     [this](Daedalus::DaedalusVM& vm){ game_initgerman(vm);      });
-  vm.registerExternalFunction("game_initenglish",    [this](Daedalus::DaedalusVM& vm){ game_initenglish(vm);     });
-
-  vm.registerExternalFunction("exitgame",            [this](Daedalus::DaedalusVM& vm){ exitgame(vm);             });
-  vm.registerExternalFunction("exitsession",         [this](Daedalus::DaedalusVM& vm){ exitsession(vm);          });
+  bindExternal("concatstrings", &GameScript::concatstrings);
+  bindExternal("inttostring",   &GameScript::inttostring  );
+  bindExternal("floattostring", &GameScript::floattostring);
+  bindExternal("inttofloat",    &GameScript::inttofloat   );
+  bindExternal("floattoint",    &GameScript::floattoint   );
+
+  bindExternal("hlp_random",          [this](Daedalus::DaedalusVM& vm){ hlp_random(vm);         });
+  bindExternal("hlp_strcmp",          &GameScript::hlp_strcmp                                   );
+  bindExternal("hlp_isvalidnpc",      [this](Daedalus::DaedalusVM& vm){ hlp_isvalidnpc(vm);     });
+  bindExternal("hlp_isvaliditem",     [this](Daedalus::DaedalusVM& vm){ hlp_isvaliditem(vm);    });
+  bindExternal("hlp_isitem",          [this](Daedalus::DaedalusVM& vm){ hlp_isitem(vm);         });
+  bindExternal("hlp_getnpc",          [this](Daedalus::DaedalusVM& vm){ hlp_getnpc(vm);         });
+  bindExternal("hlp_getinstanceid",   [this](Daedalus::DaedalusVM& vm){ hlp_getinstanceid(vm);  });
+
+  bindExternal("wld_insertnpc",       [this](Daedalus::DaedalusVM& vm){ wld_insertnpc(vm);  });
+  bindExternal("wld_insertitem",      [this](Daedalus::DaedalusVM& vm){ wld_insertitem(vm); });
+  bindExternal("wld_settime",         [this](Daedalus::DaedalusVM& vm){ wld_settime(vm);    });
+  bindExternal("wld_getday",          [this](Daedalus::DaedalusVM& vm){ wld_getday(vm);     });
+  bindExternal("wld_playeffect",      [this](Daedalus::DaedalusVM& vm){ wld_playeffect(vm); });
+  bindExternal("wld_stopeffect",      [this](Daedalus::DaedalusVM& vm){ wld_stopeffect(vm); });
+  bindExternal("wld_getplayerportalguild",
+               [this](Daedalus::DaedalusVM& vm){ wld_getplayerportalguild(vm); });
+  bindExternal("wld_setguildattitude",[this](Daedalus::DaedalusVM& vm){ wld_setguildattitude(vm);     });
+  bindExternal("wld_getguildattitude",[this](Daedalus::DaedalusVM& vm){ wld_getguildattitude(vm);     });
+  bindExternal("wld_istime",          [this](Daedalus::DaedalusVM& vm){ wld_istime(vm);               });
+  bindExternal("wld_isfpavailable",   [this](Daedalus::DaedalusVM& vm){ wld_isfpavailable(vm);        });
+  bindExternal("wld_isnextfpavailable",
+               [this](Daedalus::DaedalusVM& vm){ wld_isnextfpavailable(vm);    });
+  bindExternal("wld_ismobavailable",  [this](Daedalus::DaedalusVM& vm){ wld_ismobavailable(vm);       });
+  bindExternal("wld_setmobroutine",   [this](Daedalus::DaedalusVM& vm){ wld_setmobroutine(vm);        });
+  bindExternal("wld_getmobstate",     [this](Daedalus::DaedalusVM& vm){ wld_getmobstate(vm);          });
+  bindExternal("wld_assignroomtoguild",
+               [this](Daedalus::DaedalusVM& vm){ wld_assignroomtoguild(vm);    });
+  bindExternal("wld_detectnpc",       [this](Daedalus::DaedalusVM& vm){ wld_detectnpc(vm);            });
+  bindExternal("wld_detectnpcex",     [this](Daedalus::DaedalusVM& vm){ wld_detectnpcex(vm);          });
+  bindExternal("wld_detectitem",      [this](Daedalus::DaedalusVM& vm){ wld_detectitem(vm);           });
+
+  bindExternal("mdl_setvisual",       [this](Daedalus::DaedalusVM& vm){ mdl_setvisual(vm);        });
+  bindExternal("mdl_setvisualbody",   [this](Daedalus::DaedalusVM& vm){ mdl_setvisualbody(vm);    });
+  bindExternal("mdl_setmodelfatness", [this](Daedalus::DaedalusVM& vm){ mdl_setmodelfatness(vm);  });
+  bindExternal("mdl_applyoverlaymds", [this](Daedalus::DaedalusVM& vm){ mdl_applyoverlaymds(vm);  });
+  bindExternal("mdl_applyoverlaymdstimed",
+               [this](Daedalus::DaedalusVM& vm){ mdl_applyoverlaymdstimed(vm); });
+  bindExternal("mdl_removeoverlaymds",[this](Daedalus::DaedalusVM& vm){ mdl_removeoverlaymds(vm); });
+  bindExternal("mdl_setmodelscale",   [this](Daedalus::DaedalusVM& vm){ mdl_setmodelscale(vm);    });
+  bindExternal("mdl_startfaceani",    [this](Daedalus::DaedalusVM& vm){ mdl_startfaceani(vm);     });
+  bindExternal("mdl_applyrandomani",  [this](Daedalus::DaedalusVM& vm){ mdl_applyrandomani(vm);   });
+  bindExternal("mdl_applyrandomanifreq",
+               [this](Daedalus::DaedalusVM& vm){ mdl_applyrandomanifreq(vm);});
+
+  bindExternal("npc_settofightmode",  [this](Daedalus::DaedalusVM& vm){ npc_settofightmode(vm);   });
+  bindExternal("npc_settofistmode",   [this](Daedalus::DaedalusVM& vm){ npc_settofistmode(vm);    });
+  bindExternal("npc_isinstate",       [this](Daedalus::DaedalusVM& vm){ npc_isinstate(vm);        });
+  bindExternal("npc_wasinstate",      [this](Daedalus::DaedalusVM& vm){ npc_wasinstate(vm);       });
+  bindExternal("npc_getdisttowp",     [this](Daedalus::DaedalusVM& vm){ npc_getdisttowp(vm);      });
+  bindExternal("npc_exchangeroutine", [this](Daedalus::DaedalusVM& vm){ npc_exchangeroutine(vm);  });
+  bindExternal("npc_isdead",          [this](Daedalus::DaedalusVM& vm){ npc_isdead(vm);           });
+  bindExternal("npc_knowsinfo",       [this](Daedalus::DaedalusVM& vm){ npc_knowsinfo(vm);        });
+  bindExternal("npc_settalentskill",  [this](Daedalus::DaedalusVM& vm){ npc_settalentskill(vm);   });
+  bindExternal("npc_gettalentskill",  [this](Daedalus::DaedalusVM& vm){ npc_gettalentskill(vm);   });
+  bindExternal("npc_settalentvalue",  [this](Daedalus::DaedalusVM& vm){ npc_settalentvalue(vm);   });
+  bindExternal("npc_gettalentvalue",  [this](Daedalus::DaedalusVM& vm){ npc_gettalentvalue(vm);   });
+  bindExternal("npc_setrefusetalk",   [this](Daedalus::DaedalusVM& vm){ npc_setrefusetalk(vm);    });
+  bindExternal("npc_refusetalk",      [this](Daedalus::DaedalusVM& vm){ npc_refusetalk(vm);       });
+  bindExternal("npc_hasitems",        [this](Daedalus::DaedalusVM& vm){ npc_hasitems(vm);         });
+  bindExternal("npc_getinvitem",      [this](Daedalus::DaedalusVM& vm){ npc_getinvitem(vm);       });
+  bindExternal("npc_removeinvitem",   [this](Daedalus::DaedalusVM& vm){ npc_removeinvitem(vm);    });
+  bindExternal("npc_removeinvitems",  [this](Daedalus::DaedalusVM& vm){ npc_removeinvitems(vm);   });
+  bindExternal("npc_getbodystate",    [this](Daedalus::DaedalusVM& vm){ npc_getbodystate(vm);     });
+  bindExternal("npc_getlookattarget", [this](Daedalus::DaedalusVM& vm){ npc_getlookattarget(vm);  });
+  bindExternal("npc_getdisttonpc",    [this](Daedalus::DaedalusVM& vm){ npc_getdisttonpc(vm);     });
+  bindExternal("npc_hasequippedarmor",[this](Daedalus::DaedalusVM& vm){ npc_hasequippedarmor(vm); });
+  bindExternal("npc_setperctime",     [this](Daedalus::DaedalusVM& vm){ npc_setperctime(vm);      });
+  bindExternal("npc_percenable",      [this](Daedalus::DaedalusVM& vm){ npc_percenable(vm);       });
+  bindExternal("npc_percdisable",     [this](Daedalus::DaedalusVM& vm){ npc_percdisable(vm);      });
+  bindExternal("npc_getnearestwp",    [this](Daedalus::DaedalusVM& vm){ npc_getnearestwp(vm);     });
+  bindExternal("npc_clearaiqueue",    [this](Daedalus::DaedalusVM& vm){ npc_clearaiqueue(vm);     });
+  bindExternal("npc_isplayer",        [this](Daedalus::DaedalusVM& vm){ npc_isplayer(vm);         });
+  bindExternal("npc_getstatetime",    [this](Daedalus::DaedalusVM& vm){ npc_getstatetime(vm);     });
+  bindExternal("npc_setstatetime",    [this](Daedalus::DaedalusVM& vm){ npc_setstatetime(vm);     });
+  bindExternal("npc_changeattribute", [this](Daedalus::DaedalusVM& vm){ npc_changeattribute(vm);  });
+  bindExternal("npc_isonfp",          [this](Daedalus::DaedalusVM& vm){ npc_isonfp(vm);           });
+  bindExternal("npc_getheighttonpc",  [this](Daedalus::DaedalusVM& vm){ npc_getheighttonpc(vm);   });
+  bindExternal("npc_getequippedmeleeweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_getequippedmeleeweapon(vm); });
+  bindExternal("npc_getequippedrangedweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_getequippedrangedweapon(vm); });
+  bindExternal("npc_getequippedarmor",[this](Daedalus::DaedalusVM& vm){ npc_getequippedarmor(vm); });
+  bindExternal("npc_canseenpc",       [this](Daedalus::DaedalusVM& vm){ npc_canseenpc(vm);        });
+  bindExternal("npc_hasequippedweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_hasequippedweapon(vm); });
+  bindExternal("npc_hasequippedmeleeweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_hasequippedmeleeweapon(vm); });
+  bindExternal("npc_hasequippedrangedweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_hasequippedrangedweapon(vm); });
+  bindExternal("npc_getactivespell",  [this](Daedalus::DaedalusVM& vm){ npc_getactivespell(vm);   });
+  bindExternal("npc_getactivespellisscroll",
+               [this](Daedalus::DaedalusVM& vm){ npc_getactivespellisscroll(vm); });
+  bindExternal("npc_getactivespellcat",
+               [this](Daedalus::DaedalusVM& vm){ npc_getactivespellcat(vm); });
+  bindExternal("npc_setactivespellinfo",
+               [this](Daedalus::DaedalusVM& vm){ npc_setactivespellinfo(vm); });
+
+  bindExternal("npc_canseenpcfreelos",[this](Daedalus::DaedalusVM& vm){ npc_canseenpcfreelos(vm); });
+  bindExternal("npc_isinfightmode",   [this](Daedalus::DaedalusVM& vm){ npc_isinfightmode(vm);    });
+  bindExternal("npc_settarget",       [this](Daedalus::DaedalusVM& vm){ npc_settarget(vm);        });
+  bindExternal("npc_gettarget",       [this](Daedalus::DaedalusVM& vm){ npc_gettarget(vm);        });
+  bindExternal("npc_getnexttarget",   [this](Daedalus::DaedalusVM& vm){ npc_getnexttarget(vm);    });
+  bindExternal("npc_sendpassiveperc", [this](Daedalus::DaedalusVM& vm){ npc_sendpassiveperc(vm);  });
+  bindExternal("npc_checkinfo",       [this](Daedalus::DaedalusVM& vm){ npc_checkinfo(vm);        });
+  bindExternal("npc_getportalguild",  [this](Daedalus::DaedalusVM& vm){ npc_getportalguild(vm);   });
+  bindExternal("npc_isinplayersroom", [this](Daedalus::DaedalusVM& vm){ npc_isinplayersroom(vm);  });
+  bindExternal("npc_getreadiedweapon",[this](Daedalus::DaedalusVM& vm){ npc_getreadiedweapon(vm); });
+  bindExternal("npc_hasreadiedmeleeweapon",
+               [this](Daedalus::DaedalusVM& vm){ npc_hasreadiedmeleeweapon(vm); });
+  bindExternal("npc_isdrawingspell",  [this](Daedalus::DaedalusVM& vm){ npc_isdrawingspell(vm);   });
+  bindExternal("npc_isdrawingweapon", [this](Daedalus::DaedalusVM& vm){ npc_isdrawingweapon(vm);  });
+  bindExternal("npc_perceiveall",     [this](Daedalus::DaedalusVM& vm){ npc_perceiveall(vm);      });
+  bindExternal("npc_stopani",         [this](Daedalus::DaedalusVM& vm){ npc_stopani(vm);          });
+  bindExternal("npc_settrueguild",    [this](Daedalus::DaedalusVM& vm){ npc_settrueguild(vm);     });
+  bindExternal("npc_gettrueguild",    [this](Daedalus::DaedalusVM& vm){ npc_gettrueguild(vm);     });
+  bindExternal("npc_clearinventory",  [this](Daedalus::DaedalusVM& vm){ npc_clearinventory(vm);   });
+  bindExternal("npc_getattitude",     [this](Daedalus::DaedalusVM& vm){ npc_getattitude(vm);      });
+  bindExternal("npc_getpermattitude", [this](Daedalus::DaedalusVM& vm){ npc_getpermattitude(vm);  });
+  bindExternal("npc_setattitude",     [this](Daedalus::DaedalusVM& vm){ npc_setattitude(vm);      });
+  bindExternal("npc_settempattitude", [this](Daedalus::DaedalusVM& vm){ npc_settempattitude(vm);  });
+  bindExternal("npc_hasbodyflag",     [this](Daedalus::DaedalusVM& vm){ npc_hasbodyflag(vm);      });
+  bindExternal("npc_getlasthitspellid",
+               [this](Daedalus::DaedalusVM& vm){ npc_getlasthitspellid(vm);});
+  bindExternal("npc_getlasthitspellcat",
+               [this](Daedalus::DaedalusVM& vm){ npc_getlasthitspellcat(vm);});
+  bindExternal("npc_playani",         [this](Daedalus::DaedalusVM& vm){ npc_playani(vm);          });
+
+  bindExternal("npc_isdetectedmobownedbynpc",
+               [this](Daedalus::DaedalusVM& vm){ npc_isdetectedmobownedbynpc(vm);});
+  bindExternal("npc_getdetectedmob",  [this](Daedalus::DaedalusVM& vm){ npc_getdetectedmob(vm);   });
+  bindExternal("npc_ownedbynpc",      [this](Daedalus::DaedalusVM& vm){ npc_ownedbynpc(vm);       });
+
+  bindExternal("ai_output",           [this](Daedalus::DaedalusVM& vm){ ai_output(vm);            });
+  bindExternal("ai_stopprocessinfos", [this](Daedalus::DaedalusVM& vm){ ai_stopprocessinfos(vm);  });
+  bindExternal("ai_processinfos",     [this](Daedalus::DaedalusVM& vm){ ai_processinfos(vm);      });
+  bindExternal("ai_standup",          [this](Daedalus::DaedalusVM& vm){ ai_standup(vm);           });
+  bindExternal("ai_standupquick",     [this](Daedalus::DaedalusVM& vm){ ai_standupquick(vm);      });
+  bindExternal("ai_continueroutine",  [this](Daedalus::DaedalusVM& vm){ ai_continueroutine(vm);   });
+  bindExternal("ai_printscreen",      [this](Daedalus::DaedalusVM& vm){ printscreen(vm);          });
+  bindExternal("ai_stoplookat",       [this](Daedalus::DaedalusVM& vm){ ai_stoplookat(vm);        });
+  bindExternal("ai_lookatnpc",        [this](Daedalus::DaedalusVM& vm){ ai_lookatnpc(vm);         });
+  bindExternal("ai_removeweapon",     [this](Daedalus::DaedalusVM& vm){ ai_removeweapon(vm);      });
+  bindExternal("ai_turntonpc",        [this](Daedalus::DaedalusVM& vm){ ai_turntonpc(vm);         });
+  bindExternal("ai_outputsvm",        [this](Daedalus::DaedalusVM& vm){ ai_outputsvm(vm);         });
+  bindExternal("ai_outputsvm_overlay",[this](Daedalus::DaedalusVM& vm){ ai_outputsvm_overlay(vm); });
+  bindExternal("ai_startstate",       [this](Daedalus::DaedalusVM& vm){ ai_startstate(vm);        });
+  bindExternal("ai_playani",          [this](Daedalus::DaedalusVM& vm){ ai_playani(vm);           });
+  bindExternal("ai_setwalkmode",      [this](Daedalus::DaedalusVM& vm){ ai_setwalkmode(vm);       });
+  bindExternal("ai_wait",             [this](Daedalus::DaedalusVM& vm){ ai_wait(vm);              });
+  bindExternal("ai_waitms",           [this](Daedalus::DaedalusVM& vm){ ai_waitms(vm);            });
+  bindExternal("ai_aligntowp",        [this](Daedalus::DaedalusVM& vm){ ai_aligntowp(vm);         });
+  bindExternal("ai_gotowp",           [this](Daedalus::DaedalusVM& vm){ ai_gotowp(vm);            });
+  bindExternal("ai_gotofp",           [this](Daedalus::DaedalusVM& vm){ ai_gotofp(vm);            });
+  bindExternal("ai_playanibs",        [this](Daedalus::DaedalusVM& vm){ ai_playanibs(vm);         });
+  bindExternal("ai_equiparmor",       [this](Daedalus::DaedalusVM& vm){ ai_equiparmor(vm);        });
+  bindExternal("ai_equipbestarmor",   [this](Daedalus::DaedalusVM& vm){ ai_equipbestarmor(vm);    });
+  bindExternal("ai_equipbestmeleeweapon",
+               [this](Daedalus::DaedalusVM& vm){ ai_equipbestmeleeweapon(vm);  });
+  bindExternal("ai_equipbestrangedweapon",
+               [this](Daedalus::DaedalusVM& vm){ ai_equipbestrangedweapon(vm); });
+  bindExternal("ai_usemob",           [this](Daedalus::DaedalusVM& vm){ ai_usemob(vm);            });
+  bindExternal("ai_teleport",         [this](Daedalus::DaedalusVM& vm){ ai_teleport(vm);          });
+  bindExternal("ai_stoppointat",      [this](Daedalus::DaedalusVM& vm){ ai_stoppointat(vm);       });
+  bindExternal("ai_drawweapon",       [this](Daedalus::DaedalusVM& vm){ ai_drawweapon(vm);  });
+  bindExternal("ai_readymeleeweapon", [this](Daedalus::DaedalusVM& vm){ ai_readymeleeweapon(vm);  });
+  bindExternal("ai_readyrangedweapon",[this](Daedalus::DaedalusVM& vm){ ai_readyrangedweapon(vm); });
+  bindExternal("ai_readyspell",       [this](Daedalus::DaedalusVM& vm){ ai_readyspell(vm);        });
+  bindExternal("ai_attack",           [this](Daedalus::DaedalusVM& vm){ ai_atack(vm);             });
+  bindExternal("ai_flee",             [this](Daedalus::DaedalusVM& vm){ ai_flee(vm);              });
+  bindExternal("ai_dodge",            [this](Daedalus::DaedalusVM& vm){ ai_dodge(vm);             });
+  bindExternal("ai_unequipweapons",   [this](Daedalus::DaedalusVM& vm){ ai_unequipweapons(vm);    });
+  bindExternal("ai_unequiparmor",     [this](Daedalus::DaedalusVM& vm){ ai_unequiparmor(vm);      });
+  bindExternal("ai_gotonpc",          [this](Daedalus::DaedalusVM& vm){ ai_gotonpc(vm);           });
+  bindExternal("ai_gotonextfp",       [this](Daedalus::DaedalusVM& vm){ ai_gotonextfp(vm);        });
+  bindExternal("ai_aligntofp",        [this](Daedalus::DaedalusVM& vm){ ai_aligntofp(vm);         });
+  bindExternal("ai_useitem",          [this](Daedalus::DaedalusVM& vm){ ai_useitem(vm);           });
+  bindExternal("ai_useitemtostate",   [this](Daedalus::DaedalusVM& vm){ ai_useitemtostate(vm);    });
+  bindExternal("ai_setnpcstostate",   [this](Daedalus::DaedalusVM& vm){ ai_setnpcstostate(vm);    });
+  bindExternal("ai_finishingmove",    [this](Daedalus::DaedalusVM& vm){ ai_finishingmove(vm);     });
+
+  bindExternal("mob_hasitems",        [this](Daedalus::DaedalusVM& vm){ mob_hasitems(vm);         });
+
+  bindExternal("ta_min",              [this](Daedalus::DaedalusVM& vm){ ta_min(vm);               });
+
+  bindExternal("log_createtopic",     [this](Daedalus::DaedalusVM& vm){ log_createtopic(vm);      });
+  bindExternal("log_settopicstatus",  [this](Daedalus::DaedalusVM& vm){ log_settopicstatus(vm);   });
+  bindExternal("log_addentry",        [this](Daedalus::DaedalusVM& vm){ log_addentry(vm);         });
+
+  bindExternal("equipitem",           [this](Daedalus::DaedalusVM& vm){ equipitem(vm);            });
+  bindExternal("createinvitem",       [this](Daedalus::DaedalusVM& vm){ createinvitem(vm);        });
+  bindExternal("createinvitems",      [this](Daedalus::DaedalusVM& vm){ createinvitems(vm);       });
+
+  bindExternal("info_addchoice",      [this](Daedalus::DaedalusVM& vm){ info_addchoice(vm);       });
+  bindExternal("info_clearchoices",   [this](Daedalus::DaedalusVM& vm){ info_clearchoices(vm);    });
+  bindExternal("infomanager_hasfinished",
+               [this](Daedalus::DaedalusVM& vm){ infomanager_hasfinished(vm); });
+
+  bindExternal("snd_play",            [this](Daedalus::DaedalusVM& vm){ snd_play(vm);             });
+
+  bindExternal("doc_create",          [this](Daedalus::DaedalusVM& vm){ doc_create(vm);           });
+  bindExternal("doc_createmap",       [this](Daedalus::DaedalusVM& vm){ doc_createmap(vm);        });
+  bindExternal("doc_setpage",         [this](Daedalus::DaedalusVM& vm){ doc_setpage(vm);          });
+  bindExternal("doc_setpages",        [this](Daedalus::DaedalusVM& vm){ doc_setpages(vm);         });
+  bindExternal("doc_setmargins",      [this](Daedalus::DaedalusVM& vm){ doc_setmargins(vm);       });
+  bindExternal("doc_printline",       [this](Daedalus::DaedalusVM& vm){ doc_printline(vm);        });
+  bindExternal("doc_printlines",      [this](Daedalus::DaedalusVM& vm){ doc_printlines(vm);       });
+  bindExternal("doc_setfont",         [this](Daedalus::DaedalusVM& vm){ doc_setfont(vm);          });
+  bindExternal("doc_setlevel",        [this](Daedalus::DaedalusVM& vm){ doc_setlevel(vm);         });
+  bindExternal("doc_setlevelcoords",  [this](Daedalus::DaedalusVM& vm){ doc_setlevelcoords(vm);   });
+  bindExternal("doc_show",            [this](Daedalus::DaedalusVM& vm){ doc_show(vm);             });
+
+  bindExternal("introducechapter",    [this](Daedalus::DaedalusVM& vm){ introducechapter(vm);     });
+  bindExternal("playvideo",           [this](Daedalus::DaedalusVM& vm){ playvideo(vm);            });
+  bindExternal("playvideoex",         [this](Daedalus::DaedalusVM& vm){ playvideoex(vm);          });
+  bindExternal("printscreen",         [this](Daedalus::DaedalusVM& vm){ printscreen(vm);          });
+  bindExternal("printdialog",         [this](Daedalus::DaedalusVM& vm){ printdialog(vm);          });
+  bindExternal("print",               [this](Daedalus::DaedalusVM& vm){ print(vm);                });
+  bindExternal("perc_setrange",       [this](Daedalus::DaedalusVM& vm){ perc_setrange(vm);        });
+
+  bindExternal("printdebug",          [this](Daedalus::DaedalusVM& vm){ printdebug(vm);           });
+  bindExternal("printdebugch",        [this](Daedalus::DaedalusVM& vm){ printdebugch(vm);         });
+  bindExternal("printdebuginst",      [this](Daedalus::DaedalusVM& vm){ printdebuginst(vm);       });
+  bindExternal("printdebuginstch",    [this](Daedalus::DaedalusVM& vm){ printdebuginstch(vm);     });
+
+  bindExternal("game_initgerman",     [this](Daedalus::DaedalusVM& vm){ game_initgerman(vm);      });
+  bindExternal("game_initenglish",    [this](Daedalus::DaedalusVM& vm){ game_initenglish(vm);     });
+
+  bindExternal("exitgame",            [this](Daedalus::DaedalusVM& vm){ exitgame(vm);             });
+  bindExternal("exitsession",         [this](Daedalus::DaedalusVM& vm){ exitsession(vm);          });
 
   // vm.validateExternals();
 
-  spellFxInstanceNames = vm.getDATFile().getSymbolIndexByName("spellFxInstanceNames");
   spellFxAniLetters    = vm.getDATFile().getSymbolIndexByName("spellFxAniLetters");
 
   spells               = std::make_unique<SpellDefinitions>(vm);
   svm                  = std::make_unique<SvmDefinitions>(vm);
 
+  initCallSites();
+
   cFocusNorm           = getFocus("Focus_Normal");
   cFocusMele           = getFocus("Focus_Melee");
   cFocusRange          = getFocus("Focus_Ranged");
@@ -427,8 +453,42 @@ void GameScript::initCommon() {
       }
     }
 
-  if(hasSymbolName("startup_global"))
-    runFunction("startup_global");
+  if(callSite[SF_StartupGlobal]!=size_t(-1))
+    runFunction(callSite[SF_StartupGlobal]);
+  }
+
+void GameScript::initCallSites() {
+  static const char* names[SF_Count] = {
+    "G_CanNotUse",
+    "G_CanNotCast",
+    "player_trade_not_enough_gold",
+    "player_mob_missing_item",
+    "player_mob_missing_key",
+    "player_mob_another_is_using",
+    "player_plunder_is_empty",
+    "player_hotkey_screen_map",
+    "Spell_ProcessMana",
+    "startup_global",
+    };
+
+  auto& dat = vm.getDATFile();
+  for(size_t i=0;i<SF_Count;++i)
+    callSite[i] = dat.hasSymbolName(names[i]) ? dat.getSymbolIndexByName(names[i]) : size_t(-1);
+
+  // cast functions and effect names come from spell table; effects are loaded on first cast
+  spellVfx.assign(spells->vfxNames().size(),nullptr);
+
+  // states are resolved up front, so npc perception and routines never search by name
+  auto& sym = dat.getSymTable().symbols;
+  for(size_t i=0;i<sym.size();++i) {
+    const char* name = sym[i].name.c_str();
+    if(std::strncmp(name,"ZS_",3)!=0 || std::strchr(name,'.')!=nullptr)
+      continue;
+    size_t len = std::strlen(name);
+    if((len>5 && std::strcmp(name+len-5,"_LOOP")==0) || (len>4 && std::strcmp(name+len-4,"_END")==0))
+      continue;
+    getAiState(i);
+    }
   }
 
 void GameScript::initDialogs(Gothic& gothic) {
@@ -448,6 +508,17 @@ void GameScript::initDialogs(Gothic& gothic) {
     vm.initializeInstance(h, i, Daedalus::IC_Info);
     ++count;
     });
+
+  dialogsByNpc.clear();
+  for(auto& info:dialogsInfo)
+    dialogsByNpc[size_t(info.npc)].push_back(&info);
+  for(auto& i:dialogsByNpc) {
+    // important infos first; declaration order is kept, since conditions are evaluated in that order
+    std::stable_sort(i.second.begin(),i.second.end(),[](const Daedalus::GEngineClasses::C_Info* l,
+                                                         const Daedalus::GEngineClasses::C_Info* r){
+      return l->important>r->important;
+      });
+    }
   }
 
 void GameScript::loadDialogOU(Gothic &gothic) {
@@ -492,9 +563,12 @@ void GameScript::clearReferences(Daedalus::GEngineClasses::Instance &ptr) {
 
 void GameScript::save(Serialize &fout) {
   quests.save(fout);
-  fout.write(uint32_t(dlgKnownInfos.size()));
-  for(auto& i:dlgKnownInfos)
-    fout.write(uint32_t(i.first),uint32_t(i.second));
+  // sorted, so save doesn't depend on hash-table layout
+  std::vector<uint64_t> known(dlgKnownInfos.begin(),dlgKnownInfos.end());
+  std::sort(known.begin(),known.end());
+  fout.write(uint32_t(known.size()));
+  for(auto& i:known)
+    fout.write(uint32_t(i>>32),uint32_t(i));
 
   fout.write(uint32_t(gilAttitudes.size()));
   for(auto& i:gilAttitudes)
@@ -679,18 +753,20 @@ const AiState &GameScript::getAiState(size_t id) {
   }
 
 const Daedalus::GEngineClasses::C_Spell &GameScript::getSpell(int32_t splId) {
-  auto& spellInst = vm.getDATFile().getSymbolByIndex(spellFxInstanceNames);
-  auto& tag       = spellInst.getString(size_t(splId));
-  return spells->find(tag.c_str());
+  return spells->find(splId);
   }
 
 const VisualFx* GameScript::getSpellVFx(int32_t splId) {
-  auto& spellInst = vm.getDATFile().getSymbolByIndex(spellFxInstanceNames);
-  auto& tag       = spellInst.getString(size_t(splId));
+  if(splId<0 || size_t(splId)>=spellVfx.size())
+    return nullptr;
+  auto& fx = spellVfx[size_t(splId)];
+  if(fx==nullptr)
+    fx = owner.loadVisualFx(spells->vfxName(splId));
+  return fx;
+  }
 
-  char name[256]={};
-  std::snprintf(name,sizeof(name),"spellFX_%s",tag.c_str());
-  return owner.loadVisualFx(name);
+const std::vector<std::string>& GameScript::spellVFxNames() const {
+  return spells->vfxNames();
   }
 
 const ParticleFx* GameScript::getSpellFx(const VisualFx* vfx) {
@@ -713,18 +789,15 @@ std::vector<GameScript::DlgChoise> GameScript::dialogChoises(Daedalus::GEngineCl
   ScopeVar self (vm, vm.globalSelf(),  hnpc,   Daedalus::IC_Npc);
   ScopeVar other(vm, vm.globalOther(), player, Daedalus::IC_Npc);
 
-  std::vector<Daedalus::GEngineClasses::C_Info*> hDialog;
-  for(auto& info : dialogsInfo) {
-    if(info.npc==int32_t(npc.instanceSymbol)) {
-      hDialog.push_back(&info);
-      }
-    }
+  auto& hDialog = npcDialogs(npc);
 
   std::vector<DlgChoise> choise;
 
   for(int important=includeImp ? 1 : 0;important>=0;--important){
     for(auto& i:hDialog) {
       const Daedalus::GEngineClasses::C_Info& info = *i;
+      if(info.important<important)
+        break;
       if(info.important!=important)
         continue;
       bool npcKnowsInfo = doesNpcKnowInfo(pl,info.instanceSymbol);
@@ -811,7 +884,7 @@ void GameScript::exec(const GameScript::DlgChoise &dlg,Npc& player, Npc& npc) {
   }
 
 int GameScript::printCannotUseError(Npc& npc, int32_t atr, int32_t nValue) {
-  auto id = vm.getDATFile().getSymbolIndexByName("G_CanNotUse");
+  auto id = callSite[SF_CanNotUse];
   if(id==size_t(-1))
     return 0;
   vm.pushInt(npc.isPlayer() ? 1 : 0);
@@ -822,7 +895,7 @@ int GameScript::printCannotUseError(Npc& npc, int32_t atr, int32_t nValue) {
   }
 
 int GameScript::printCannotCastError(Npc &npc, int32_t plM, int32_t itM) {
-  auto id = vm.getDATFile().getSymbolIndexByName("G_CanNotCast");
+  auto id = callSite[SF_CanNotCast];
   if(id==size_t(-1))
     return 0;
   vm.pushInt(npc.isPlayer() ? 1 : 0);
@@ -833,7 +906,7 @@ int GameScript::printCannotCastError(Npc &npc, int32_t plM, int32_t itM) {
   }
 
 int GameScript::printCannotBuyError(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_trade_not_enough_gold");
+  auto id = callSite[SF_TradeNotEnoughGold];
   if(id==size_t(-1))
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
@@ -841,7 +914,7 @@ int GameScript::printCannotBuyError(Npc &npc) {
   }
 
 int GameScript::printMobMissingItem(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_item");
+  auto id = callSite[SF_MobMissingItem];
   if(id==size_t(-1))
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
@@ -849,7 +922,7 @@ int GameScript::printMobMissingItem(Npc &npc) {
   }
 
 int GameScript::printMobMissingKey(Npc& npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_missing_key");
+  auto id = callSite[SF_MobMissingKey];
   if(id==size_t(-1))
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
@@ -857,24 +930,13 @@ int GameScript::printMobMissingKey(Npc& npc) {
   }
 
 int GameScript::printMobAnotherIsUsing(Npc &npc) {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_mob_another_is_using");
+  auto id = callSite[SF_MobAnotherIsUsing];
   if(id==size_t(-1))
     return 0;
   ScopeVar self(vm, vm.globalSelf(), npc.handle(), Daedalus::IC_Npc);
   return runFunction(id,true);
   }
 
-int GameScript::invokeState(Daedalus::GEngineClasses::C_Npc* hnpc, Daedalus::GEngineClasses::C_Npc* oth, const char *name) {
-  auto& dat = vm.getDATFile();
-  auto  id  = dat.getSymbolIndexByName(name);
-  if(id==size_t(-1))
-    return 0;
-
-  ScopeVar self (vm, vm.globalSelf(),  hnpc, Daedalus::IC_Npc);
-  ScopeVar other(vm, vm.globalOther(), oth,  Daedalus::IC_Npc);
-  return runFunction(id);
-  }
-
 int GameScript::invokeState(Npc* npc, Npc* oth, Npc* vic, size_t fn) {
   if(fn==size_t(-1))
     return 0;
@@ -911,8 +973,7 @@ int GameScript::invokeItem(Npc *npc,size_t fn) {
   }
 
 int GameScript::invokeMana(Npc &npc, Npc* target, Item &) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("Spell_ProcessMana");
+  auto fn = callSite[SF_ProcessMana];
   if(fn==size_t(-1))
     return Npc::SpellCode::SPL_SENDSTOP;
 
@@ -924,13 +985,7 @@ int GameScript::invokeMana(Npc &npc, Npc* target, Item &) {
   }
 
 int GameScript::invokeSpell(Npc &npc, Npc* target, Item &it) {
-  auto& spellInst = vm.getDATFile().getSymbolByIndex(spellFxInstanceNames);
-  auto& tag       = spellInst.getString(size_t(it.spellId()));
-  char  str[256]={};
-  std::snprintf(str,sizeof(str),"Spell_Cast_%s",tag.c_str());
-
-  auto& dat = vm.getDATFile();
-  auto  fn  = dat.getSymbolIndexByName(str);
+  const size_t fn = spells->castFunc(it.spellId());
   if(fn==size_t(-1))
     return 0;
 
@@ -940,7 +995,7 @@ int GameScript::invokeSpell(Npc &npc, Npc* target, Item &it) {
     return runFunction(fn);
     }
   catch(...){
-    Log::d("unable to call spell-script: \"",str,"\'");
+    Log::d("unable to call spell-script: \"",getSymbol(fn).name.c_str(),"\'");
     return 0;
     }
   }
@@ -952,8 +1007,7 @@ int GameScript::invokeCond(Npc &,const char* func) {
   }
 
 int GameScript::playerHotKeyScreenMap(Npc& pl) {
-  auto& dat = vm.getDATFile();
-  auto fn   = dat.getSymbolIndexByName("player_hotkey_screen_map");
+  auto fn = callSite[SF_HotKeyScreenMap];
   if(fn==size_t(-1))
     return -1;
 
@@ -1038,24 +1092,20 @@ uint32_t GameScript::messageTime(const Daedalus::ZString& id) const {
   }
 
 int GameScript::printNothingToGet() {
-  auto id = vm.getDATFile().getSymbolIndexByName("player_plunder_is_empty");
+  auto id = callSite[SF_PlunderIsEmpty];
   if(id==size_t(-1))
     return 0;
   ScopeVar self(vm, vm.globalSelf(), owner.player());
   return runFunction(id,false);
   }
 
-void GameScript::useInteractive(Daedalus::GEngineClasses::C_Npc* hnpc,const std::string& func) {
-  auto& dat = vm.getDATFile();
-  if(!dat.hasSymbolName(func.c_str()))
-    return;
-
+void GameScript::useInteractive(Daedalus::GEngineClasses::C_Npc* hnpc,size_t func) {
   ScopeVar self(vm,vm.globalSelf(),hnpc,Daedalus::IC_Npc);
   try {
-    runFunction(func.c_str());
+    runFunction(func,true);
     }
   catch (...) {
-    Log::i("unable to use interactive [",func,"]");
+    Log::i("unable to use interactive [",vm.getDATFile().getSymbolByIndex(func).name,"]");
     }
   }
 
@@ -1131,7 +1181,11 @@ int32_t GameScript::runFunction(const size_t fid,bool clearStk) {
   auto&       sym  = dat.getSymbolByIndex(fid);
   const char* call = sym.name.c_str();(void)call; //for debuging
 
-  int32_t ret = vm.runFunctionBySymIndex(fid,clearStk);
+  int32_t ret = 0;
+  {
+  ScriptProfiler::Scope prof(profiler.get(),fid,call);
+  ret = vm.runFunctionBySymIndex(fid,clearStk);
+  }
   invokeRecursive--;
   return ret;
   }
@@ -1144,6 +1198,10 @@ uint32_t GameScript::rand(uint32_t max) {
   return uint32_t(randGen())%max;
   }
 
+void GameScript::seed(uint32_t s) {
+  randSeed = s;
+  }
+
 template<class Ret,class ... Args>
 std::function<Ret(Args...)> GameScript::notImplementedFn(){
   struct _{
@@ -2217,8 +2275,11 @@ void GameScript::npc_checkinfo(Daedalus::DaedalusVM &vm) {
   auto& pl   = *(hpl);
   auto& npc  = *(n->handle());
 
-  for(auto& info:dialogsInfo) {
-    if(info.npc!=int32_t(npc.instanceSymbol) || info.important!=imp)
+  for(auto i:npcDialogs(npc)) {
+    auto& info = *i;
+    if(info.important<imp)
+      break;
+    if(info.important!=imp)
       continue;
     bool npcKnowsInfo = doesNpcKnowInfo(pl,info.instanceSymbol);
     if(npcKnowsInfo && !info.permanent)
@@ -3240,13 +3301,23 @@ void GameScript::sort(std::vector<GameScript::DlgChoise> &dlg) {
   }
 
 void GameScript::setNpcInfoKnown(const Daedalus::GEngineClasses::C_Npc& npc, const Daedalus::GEngineClasses::C_Info &info) {
-  auto id = std::make_pair(npc.instanceSymbol,info.instanceSymbol);
-  dlgKnownInfos.insert(id);
+  dlgKnownInfos.insert(knownInfoKey(npc.instanceSymbol,info.instanceSymbol));
   }
 
 bool GameScript::doesNpcKnowInfo(const Daedalus::GEngineClasses::C_Npc& npc, size_t infoInstance) const {
-  auto id = std::make_pair(npc.instanceSymbol,infoInstance);
-  return dlgKnownInfos.find(id)!=dlgKnownInfos.end();
+  return dlgKnownInfos.find(knownInfoKey(npc.instanceSymbol,infoInstance))!=dlgKnownInfos.end();
+  }
+
+const std::vector<Daedalus::GEngineClasses::C_Info*>& GameScript::npcDialogs(const Daedalus::GEngineClasses::C_Npc& npc) const {
+  static const std::vector<Daedalus::GEngineClasses::C_Info*> empty;
+  auto it = dialogsByNpc.find(npc.instanceSymbol);
+  if(it==dialogsByNpc.end())
+    return empty;
+  return it->second;
+  }
+
+uint64_t GameScript::knownInfoKey(size_t npc, size_t infoInstance) {
+  return (uint64_t(uint32_t(npc))<<32) | uint64_t(uint32_t(infoInstance));
   }
 
 
@@ -28,6 +28,7 @@ class Item;
 class VisualFx;
 class ParticleFx;
 class Serialize;
+class ScriptProfiler;
 
 class GameScript final {
   public:
@@ -67,6 +68,7 @@ class GameScript final {
     uint64_t     tickCount() const;
 
     uint32_t     rand(uint32_t max);
+    static void  seed(uint32_t s); // seed of script random generator, for sessions created afterwards
     void         removeItem(Item& it);
 
     void         setInstanceNPC(const char* name,Npc& npc);
@@ -93,6 +95,7 @@ class GameScript final {
     const AiState&                                    getAiState(size_t id);
     const Daedalus::GEngineClasses::C_Spell&          getSpell(int32_t splId);
     const VisualFx*                                   getSpellVFx(int32_t splId);
+    const std::vector<std::string>&                   spellVFxNames() const;
     const ParticleFx*                                 getSpellFx(const VisualFx* vfx);
     const ParticleFx*                                 getParticleFx(const char* symbol);
 
@@ -107,7 +110,6 @@ class GameScript final {
     int  printMobMissingKey    (Npc &npc);
     int  printMobAnotherIsUsing(Npc &npc);
 
-    int  invokeState(Daedalus::GEngineClasses::C_Npc *hnpc, Daedalus::GEngineClasses::C_Npc *hother, const char* name);
     int  invokeState(Npc* npc, Npc* other, Npc *victum, size_t fn);
     int  invokeItem (Npc* npc, size_t fn);
     int  invokeMana (Npc& npc, Npc* target, Item&  fn);
@@ -129,14 +131,30 @@ class GameScript final {
 
     int      printNothingToGet();
     float    tradeValueMultiplier() const { return tradeValMult; }
-    void     useInteractive(Daedalus::GEngineClasses::C_Npc *hnpc, const std::string &func);
+    void     useInteractive(Daedalus::GEngineClasses::C_Npc *hnpc, size_t func);
     Attitude guildAttitude(const Npc& p0,const Npc& p1) const;
     Attitude personAttitude(const Npc& p0,const Npc& p1) const;
 
     BodyState schemeToBodystate(const char* sc);
 
   private:
+    enum ScriptFn : uint8_t {
+      SF_CanNotUse,
+      SF_CanNotCast,
+      SF_TradeNotEnoughGold,
+      SF_MobMissingItem,
+      SF_MobMissingKey,
+      SF_MobAnotherIsUsing,
+      SF_PlunderIsEmpty,
+      SF_HotKeyScreenMap,
+      SF_ProcessMana,
+      SF_StartupGlobal,
+      SF_Count
+      };
+
     void               initCommon();
+    void               initCallSites();
+    void               bindExternal(const char* name, std::function<void(Daedalus::DaedalusVM&)> fn);
 
     struct GlobalOutput : AiOuputPipe {
       GlobalOutput(GameScript& owner):owner(owner){}
@@ -397,6 +415,8 @@ class GameScript final {
     void sort(std::vector<DlgChoise>& dlg);
     void setNpcInfoKnown(const Daedalus::GEngineClasses::C_Npc& npc, const Daedalus::GEngineClasses::C_Info& info);
     bool doesNpcKnowInfo(const Daedalus::GEngineClasses::C_Npc& npc, size_t infoInstance) const;
+    auto npcDialogs(const Daedalus::GEngineClasses::C_Npc& npc) const -> const std::vector<Daedalus::GEngineClasses::C_Info*>&;
+    static uint64_t knownInfoKey(size_t npc, size_t infoInstance);
 
     void saveSym(Serialize& fout,const Daedalus::PARSymbol& s);
 
@@ -404,13 +424,15 @@ class GameScript final {
     uint8_t                                                     invokeRecursive=0;
     GameSession&                                                owner;
     std::mt19937                                                randGen;
+    static uint32_t                                             randSeed;
 
     std::unique_ptr<SpellDefinitions>                           spells;
     std::unique_ptr<SvmDefinitions>                             svm;
     uint64_t                                                    svmBarrier=0;
 
-    std::set<std::pair<size_t,size_t>>                          dlgKnownInfos;
+    std::unordered_set<uint64_t>                                dlgKnownInfos;
     std::vector<Daedalus::GEngineClasses::C_Info>               dialogsInfo;
+    std::unordered_map<size_t,std::vector<Daedalus::GEngineClasses::C_Info*>> dialogsByNpc;
     std::unique_ptr<ZenLoad::zCCSLib>                           dialogs;
     std::unordered_map<size_t,AiState>                          aiStates;
     std::unique_ptr<AiOuputPipe>                                aiDefaultPipe;
@@ -418,8 +440,9 @@ class GameScript final {
     QuestLog                                                    quests;
     size_t                                                      itMi_Gold=0;
     float                                                       tradeValMult=0.3f;
-    size_t                                                      spellFxInstanceNames=0;
     size_t                                                      spellFxAniLetters=0;
+    size_t                                                      callSite[SF_Count]={};
+    std::vector<const VisualFx*>                                spellVfx;
     std::string                                                 goldTxt;
     float                                                       viewTimePerChar=0.5;
     size_t                                                      gilCount=0;
@@ -436,4 +459,5 @@ class GameScript final {
     Daedalus::GEngineClasses::C_GilValues                       cGuildVal;
 
     std::vector<std::unique_ptr<DocumentMenu::Show>>            documents;
+    std::unique_ptr<ScriptProfiler>                             profiler;
   };
@@ -104,6 +104,7 @@ GameSession::GameSession(Gothic &gothic, const RendererStorage &storage, Seriali
   gothic.setLoadingProgress(70);
   wrld->load(fin);
   vm->loadVar(fin);
+  wrld->prefetchItemFx();
   if(auto hero = wrld->player())
     vm->setInstanceNPC("HERO",*hero);
   cam.load(fin,wrld->player());
@@ -123,6 +124,10 @@ void GameSession::save(Serialize &fout, const char* name, const Pixmap& screen)
   hdr.isGothic2 = gothic.version().game;
 
   fout.write(hdr,ticks,wrldTimePart);
+  saveState(fout);
+  }
+
+void GameSession::saveState(Serialize &fout) {
   fout.write(uint16_t(visitedWorlds.size()));
 
   gothic.setLoadingProgress(5);
@@ -171,6 +176,18 @@ bool GameSession::isRamboMode() const {
   return gothic.isRamboMode();
   }
 
+bool GameSession::isScriptProfile() const {
+  return gothic.doScriptProfile();
+  }
+
+const std::string& GameSession::scriptTraceFile() const {
+  return gothic.scriptTraceFile();
+  }
+
+uint32_t GameSession::scriptTraceEvents() const {
+  return gothic.scriptTraceEvents();
+  }
+
 const VersionInfo& GameSession::version() const {
   return gothic.version();
   }
@@ -205,6 +222,10 @@ const ParticleFx* GameSession::loadParticleFx(const char *name) {
   return gothic.loadParticleFx(name);
   }
 
+void GameSession::prefetchFx(const std::vector<std::string>& vfx, std::vector<std::string> pfx, bool newWorld) {
+  gothic.prefetchFx(vfx,std::move(pfx),newWorld);
+  }
+
 Tempest::SoundEffect GameSession::loadSound(const Tempest::Sound &raw) {
   return sound.load(raw);
   }
@@ -281,7 +302,7 @@ void GameSession::tick(uint64_t dt) {
 
     const char *w = (beg!=std::string::npos) ? (chWorld.zen.c_str()+beg+1) : chWorld.zen.c_str();
 
-    if(Resources::vdfsIndex().hasFile(w)) {
+    if(Resources::hasFile(w)) {
       std::snprintf(buf,sizeof(buf),"LOADING_%s.TGA",wname.c_str());  // format load-screen name, like "LOADING_OLDWORLD.TGA"
 
       gothic.startLoad(buf,[this](std::unique_ptr<GameSession>&& game){
@@ -300,7 +321,7 @@ auto GameSession::implChangeWorld(std::unique_ptr<GameSession>&& game,
   if(cut!=std::string::npos)
     w = w+cut+1;
 
-  if(!Resources::vdfsIndex().hasFile(w)) {
+  if(!Resources::hasFile(w)) {
     Log::i("World not found[",world,"]");
     return std::move(game);
     }
@@ -447,5 +468,7 @@ void GameSession::initScripts(bool firstTime) {
   if(vm->hasSymbolName(init.c_str()))
     vm->runFunction(init.c_str());
 
+  // npc and their equipment exist only after startup scripts
+  wrld->prefetchItemFx();
   wrld->resetPositionToTA();
   }
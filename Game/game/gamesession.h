@@ -34,6 +34,7 @@ class GameSession final {
     ~GameSession();
 
     void         save(Serialize& fout, const char *name, const Tempest::Pixmap &screen);
+    void         saveState(Serialize& fout);
 
     void         setWorld(std::unique_ptr<World> &&w);
     auto         clearWorld() -> std::unique_ptr<World>;
@@ -42,6 +43,9 @@ class GameSession final {
     void         exitSession();
 
     bool         isRamboMode() const;
+    bool         isScriptProfile() const;
+    auto         scriptTraceFile() const -> const std::string&;
+    uint32_t     scriptTraceEvents() const;
     auto         version() const -> const VersionInfo&;
 
     const World* world() const { return wrld.get(); }
@@ -56,6 +60,7 @@ class GameSession final {
     SoundFx*     loadSoundWavFx(const char *name);
     auto         loadParticleFx(const char* name) -> const ParticleFx*;
     auto         loadVisualFx(const char* name) -> const VisualFx*;
+    void         prefetchFx(const std::vector<std::string>& vfx, std::vector<std::string> pfx, bool newWorld);
     auto         loadSound(const Tempest::Sound& raw) -> Tempest::SoundEffect;
     auto         loadSound(const SoundFx&        fx)  -> GSoundEffect;
     void         emitGlobalSound(const Tempest::Sound& sfx);
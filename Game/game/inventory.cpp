@@ -23,6 +23,8 @@ void Inventory::implLoad(Npc* owner, World& world, Serialize &s) {
   s.read(sz);
   for(size_t i=0;i<sz;++i)
     items.emplace_back(std::make_unique<Item>(world,s,false));
+  sorted=false;
+  reindex();
 
   s.read(sz);
   mdlSlots.resize(sz);
@@ -127,30 +129,26 @@ void Inventory::save(Serialize &fout) const {
   }
 
 int32_t Inventory::priceOf(size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->cost();
+  if(auto it = findByClass(cls))
+    return it->cost();
   return 0;
   }
 
 int32_t Inventory::sellPriceOf(size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->sellCost();
+  if(auto it = findByClass(cls))
+    return it->sellCost();
   return 0;
   }
 
 size_t Inventory::goldCount() const {
-  for(auto& i:items)
-    if(i->isGold())
-      return i->count();
+  if(gold!=nullptr)
+    return gold->count();
   return 0;
   }
 
 size_t Inventory::itemCount(const size_t cls) const {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i->count();
+  if(auto it = findByClass(cls))
+    return it->count();
   return 0;
   }
 
@@ -208,15 +206,13 @@ Item* Inventory::addItem(std::unique_ptr<Item> &&p) {
   using namespace Daedalus::GEngineClasses;
   if(p==nullptr)
     return nullptr;
-  sorted=false;
 
   const auto cls = p->clsId();
   p->setView(MeshObjects::Mesh());
   Item* it=findByClass(cls);
   if(it==nullptr) {
     p->clearView();
-    items.emplace_back(std::move(p));
-    return items.back().get();
+    return insertItem(std::move(p));
     } else {
     auto& c = *p->handle();
     it->handle()->amount += c.amount;
@@ -236,7 +232,6 @@ Item* Inventory::addItem(size_t itemSymbol, uint32_t count, World &owner) {
   using namespace Daedalus::GEngineClasses;
   if(count<=0)
     return nullptr;
-  sorted=false;
 
   Item* it=findByClass(itemSymbol);
   if(it==nullptr) {
@@ -244,8 +239,7 @@ Item* Inventory::addItem(size_t itemSymbol, uint32_t count, World &owner) {
       std::unique_ptr<Item> ptr{new Item(owner,itemSymbol)};
       ptr->clearView();
       ptr->setCount(count);
-      items.emplace_back(std::move(ptr));
-      return items.back().get();
+      return insertItem(std::move(ptr));
       }
     catch(const Daedalus::InvalidCall& call) {
       Log::e("[invalid call in VM, while initializing item: ",itemSymbol,"]");
@@ -290,10 +284,10 @@ void Inventory::delItem(Item *it, uint32_t count, Npc& owner) {
       } else {
       ++i;
       }
-  sorted=false;
 
+  unindexItem(it);
   for(size_t i=0;i<items.size();++i)
-    if(items[i]->clsId()==itData.instanceSymbol){
+    if(items[i].get()==it){
       items.erase(items.begin()+int(i));
       break;
       }
@@ -305,9 +299,6 @@ void Inventory::trasfer(Inventory &to, Inventory &from, Npc* fromNpc, size_t ite
     if(it.clsId()!=itemSymbol)
       continue;
 
-    from.sorted = false;
-    to.sorted   = false;
-
     auto  handle = it.handle();
     auto& itData = *handle;
     if(count>itData.amount)
@@ -321,6 +312,7 @@ void Inventory::trasfer(Inventory &to, Inventory &from, Npc* fromNpc, size_t ite
           }
         from.unequip(&it,*fromNpc);
         }
+      from.unindexItem(&it);
       to.addItem(std::move(from.items[i]));
       from.items.erase(from.items.begin()+int(i));
       } else {
@@ -495,6 +487,7 @@ void Inventory::clear(GameScript&, Npc&) {
       used.emplace_back(std::move(i));
       }
   items = std::move(used); // Gothic don't clear items, which are in use
+  reindex();
   }
 
 const Item *Inventory::activeWeapon() const {
@@ -772,6 +765,7 @@ bool Inventory::equip(size_t cls, Npc &owner, bool force) {
   }
 
 void Inventory::invalidateCond(Npc &owner) {
+  ++condEpoch;
   if(!owner.isPlayer())
     return; // gothic doesn't care
   invalidateCond(armour,owner);
@@ -818,31 +812,123 @@ void Inventory::equipBestArmour(Npc &owner) {
   }
 
 Item *Inventory::findByClass(size_t cls) {
-  for(auto& i:items)
-    if(i->clsId()==cls)
-      return i.get();
+  auto i = byClass.find(cls);
+  if(i!=byClass.end())
+    return i->second;
   return nullptr;
   }
 
-Item* Inventory::bestItem(Npc &owner, Inventory::Flags f) {
-  Item* ret=nullptr;
-  int   g  =-1;
-  for(auto& i:items) {
-    auto& itData = *i->handle();
-    auto  flag   = Flags(itData.mainflag);
-    if((flag & f)==0)
-      continue;
-    if(!i->checkCond(owner))
-      continue;
+const Item* Inventory::findByClass(size_t cls) const {
+  auto i = byClass.find(cls);
+  if(i!=byClass.end())
+    return i->second;
+  return nullptr;
+  }
 
-    if(itData.value>g){
-      ret=i.get();
-      g = itData.value;
-      }
+Item* Inventory::insertItem(std::unique_ptr<Item>&& p) {
+  Item* ret = p.get();
+  if(sorted) {
+    // keep display order, instead of resorting whole inventory on next access
+    auto at = std::upper_bound(items.begin(),items.end(),p,[](const std::unique_ptr<Item>& l,const std::unique_ptr<Item>& r){
+      return less(*l,*r);
+      });
+    items.emplace(at,std::move(p));
+    } else {
+    items.emplace_back(std::move(p));
     }
+  indexItem(ret);
   return ret;
   }
 
+void Inventory::indexItem(Item* it) {
+  byClass[it->clsId()] = it;
+  if(it->isGold())
+    gold = it;
+
+  const uint32_t flag = uint32_t(it->mainFlag());
+  for(uint32_t bit=0; bit<32; ++bit) {
+    int id = categoryId(flag & (1u<<bit));
+    if(id<0)
+      continue;
+    // sorted by value, most valuable first; equal values - in order of arrival
+    auto& cat = category[id];
+    auto  at  = std::upper_bound(cat.begin(),cat.end(),it->cost(),[](int32_t v,const Candidate& c){
+      return v>c.item->cost();
+      });
+    Candidate c;
+    c.item = it;
+    cat.insert(at,c);
+    }
+  }
+
+void Inventory::unindexItem(Item* it) {
+  auto i = byClass.find(it->clsId());
+  if(i!=byClass.end() && i->second==it)
+    byClass.erase(i);
+  if(gold==it)
+    gold = nullptr;
+
+  for(auto& cat:category)
+    for(size_t i=0;i<cat.size();++i)
+      if(cat[i].item==it) {
+        cat.erase(cat.begin()+int(i));
+        break;
+        }
+  }
+
+void Inventory::reindex() {
+  byClass.clear();
+  gold = nullptr;
+  for(auto& cat:category)
+    cat.clear();
+  for(auto& i:items)
+    indexItem(i.get());
+  }
+
+int Inventory::categoryId(uint32_t flag) {
+  if(flag==ITM_CAT_MAGIC)
+    return CAT_COUNT-1;
+  for(int i=0;i+1<CAT_COUNT;++i)
+    if(flag==(1u<<i))
+      return i;
+  return -1;
+  }
+
+void Inventory::updateCondEpoch(const Npc& owner) {
+  // scripts may write attributes directly, so compare with state of last evaluation
+  const size_t cnt = Npc::ATR_MAX+1;
+  bool         eq  = (condState.size()==cnt);
+  condState.resize(cnt);
+  for(size_t i=0;i<Npc::ATR_MAX;++i) {
+    int32_t v = owner.attribute(Npc::Attribute(i));
+    eq &= (condState[i]==v);
+    condState[i] = v;
+    }
+  eq &= (condState[Npc::ATR_MAX]==owner.mageCycle());
+  condState[Npc::ATR_MAX] = owner.mageCycle();
+  if(!eq)
+    ++condEpoch;
+  }
+
+bool Inventory::checkCond(Candidate& c, const Npc& owner) {
+  if(c.epoch!=condEpoch) {
+    c.cond  = c.item->checkCond(owner);
+    c.epoch = condEpoch;
+    }
+  return c.cond;
+  }
+
+Item* Inventory::bestItem(Npc &owner, Inventory::Flags f) {
+  int id = categoryId(f);
+  if(id<0)
+    return nullptr;
+  updateCondEpoch(owner);
+  for(auto& i:category[id])
+    if(checkCond(i,owner))
+      return i.item;
+  return nullptr;
+  }
+
 Item *Inventory::bestArmour(Npc &owner) {
   return bestItem(owner,ITM_CAT_ARMOR);
   }
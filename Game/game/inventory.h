@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <daedalus/DaedalusGameState.h>
 
 #include "game/constants.h"
@@ -116,11 +117,21 @@ class Inventory final {
     void   setStateItem  (size_t cls);
 
   private:
+    enum {
+      CAT_COUNT = 11 // ITM_CAT_NONE..ITM_CAT_RUNE + ITM_CAT_MAGIC
+      };
+
     struct MdlSlot final {
       std::string slot;
       Item*       item = nullptr;
       };
 
+    struct Candidate final {
+      Item*    item  = nullptr;
+      uint64_t epoch = 0; // condEpoch, when 'cond' was evaluated; 0 - never
+      bool     cond  = false;
+      };
+
     void   implLoad(Npc *owner, World &world, Serialize& s);
     void   implPutState(Npc& owner, size_t cls, const char* slot);
 
@@ -129,9 +140,18 @@ class Inventory final {
     void   applyArmour (Item& it, Npc &owner, int32_t sgn);
 
     Item*  findByClass(size_t cls);
+    const Item* findByClass(size_t cls) const;
+    Item*  insertItem (std::unique_ptr<Item>&& p);
     void   delItem    (Item* it, uint32_t count, Npc& owner);
     void   invalidateCond(Item*& slot,  Npc &owner);
 
+    void   indexItem  (Item* it);
+    void   unindexItem(Item* it);
+    void   reindex();
+    static int categoryId(uint32_t flag);
+    void   updateCondEpoch(const Npc& owner);
+    bool   checkCond(Candidate& c, const Npc& owner);
+
     Item*  bestItem       (Npc &owner, Flags f);
     Item*  bestArmour     (Npc &owner);
     Item*  bestMeleeWeapon(Npc &owner);
@@ -148,6 +168,12 @@ class Inventory final {
     mutable std::vector<std::unique_ptr<Item>> items;
     mutable bool                               sorted=false;
 
+    std::unordered_map<size_t,Item*>   byClass;
+    std::vector<Candidate>             category[CAT_COUNT];
+    Item*                              gold=nullptr;
+    std::vector<int32_t>               condState;
+    uint64_t                           condEpoch=1;
+
     uint32_t                           indexOf(const Item* it) const;
     Item*                              readPtr(Serialize& fin);
 
@@ -0,0 +1,134 @@
+#include "scriptprofiler.h"
+
+#include <Tempest/Log>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+using namespace Tempest;
+
+ScriptProfiler::ScriptProfiler(const std::string& traceFile, uint32_t maxEvents)
+  :traceFile(sessionFile(traceFile)), maxEvents(maxEvents) {
+  epoch = now();
+  }
+
+std::string ScriptProfiler::sessionFile(const std::string& traceFile) {
+  static std::atomic<uint32_t> session{0};
+  if(traceFile.empty())
+    return traceFile;
+
+  char num[16]={};
+  std::snprintf(num,sizeof(num),"-%u",unsigned(session.fetch_add(1)+1));
+
+  auto slash = traceFile.find_last_of("/\\");
+  auto dot   = traceFile.rfind('.');
+  if(dot==std::string::npos || (slash!=std::string::npos && dot<slash))
+    return traceFile+num;
+  return traceFile.substr(0,dot)+num+traceFile.substr(dot);
+  }
+
+uint64_t ScriptProfiler::now() const {
+  auto t = std::chrono::steady_clock::now().time_since_epoch();
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count())-epoch;
+  }
+
+void ScriptProfiler::enter(size_t sym, const char* name) {
+  auto& s = stat[sym];
+  if(s.calls==0 && name!=nullptr)
+    s.name = name;
+  s.calls++;
+  s.active++;
+
+  Frame f;
+  f.sym   = sym;
+  f.start = now();
+  stack.push_back(f);
+  }
+
+void ScriptProfiler::leave() {
+  if(stack.empty())
+    return;
+  const Frame    f   = stack.back();
+  const uint64_t dur = now()-f.start;
+  stack.pop_back();
+
+  auto& s = stat[f.sym];
+  s.active--;
+  // recursive calls are already covered by outermost frame
+  if(s.active==0)
+    s.incl += dur;
+  s.excl += dur-std::min(dur,f.child);
+  if(!stack.empty())
+    stack.back().child += dur;
+
+  if(!traceFile.empty() && events.size()<maxEvents)
+    events.push_back(Event{f.sym,f.start,dur,uint32_t(stack.size())});
+  }
+
+const ScriptProfiler::Stat* ScriptProfiler::stats(size_t sym) const {
+  auto it = stat.find(sym);
+  if(it==stat.end())
+    return nullptr;
+  return &it->second;
+  }
+
+void ScriptProfiler::report() const {
+  std::vector<const Stat*> st;
+  st.reserve(stat.size());
+  for(auto& i:stat)
+    st.push_back(&i.second);
+  std::sort(st.begin(),st.end(),[](const Stat* l,const Stat* r){
+    return l->excl>r->excl;
+    });
+
+  uint64_t total = 0;
+  for(auto i:st)
+    total += i->excl;
+
+  char buf[256]={};
+  Log::i("script profile: ",uint32_t(st.size())," functions, ",uint32_t(total/1000000)," ms total");
+  Log::i("      calls   incl, ms   excl, ms  function");
+  for(size_t i=0;i<st.size() && i<64;++i) {
+    auto& s = *st[i];
+    std::snprintf(buf,sizeof(buf),"%11llu %10.3f %10.3f  %s",
+                  static_cast<unsigned long long>(s.calls),double(s.incl)/1e6,double(s.excl)/1e6,s.name.c_str());
+    Log::i(buf);
+    }
+  }
+
+bool ScriptProfiler::writeTrace() const {
+  if(traceFile.empty())
+    return true;
+
+  std::ofstream fout(traceFile,std::ios::binary);
+  if(!fout) {
+    Log::e("unable to write script trace: \"",traceFile,"\"");
+    return false;
+    }
+
+  fout << "{\"traceEvents\":[\n";
+  char buf[64]={};
+  for(size_t i=0;i<events.size();++i) {
+    auto& e  = events[i];
+    auto  it = stat.find(e.sym);
+    fout << (i==0 ? "" : ",\n") << "{\"name\":\"";
+    if(it!=stat.end()) {
+      for(char c:it->second.name) {
+        if(c=='"' || c=='\\')
+          fout << '\\';
+        fout << c;
+        }
+      }
+    std::snprintf(buf,sizeof(buf),"%.3f",double(e.start)/1000.0);
+    fout << "\",\"cat\":\"script\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << buf;
+    std::snprintf(buf,sizeof(buf),"%.3f",double(e.dur)/1000.0);
+    fout << ",\"dur\":" << buf << ",\"args\":{\"depth\":" << e.depth << "}}";
+    }
+  fout << "\n]}\n";
+  if(events.size()>=maxEvents)
+    Log::i("script trace is truncated to ",maxEvents," events");
+  Log::i("script trace: \"",traceFile,"\"");
+  return bool(fout);
+  }
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class ScriptProfiler final {
+  public:
+    enum : uint32_t { DefaultMaxEvents = 4*1024*1024 }; // ~128 MB, events are kept only for trace file
+
+    // each profiler writes own trace: '<name>-<session>.<ext>', so later game sessions don't overwrite earlier
+    ScriptProfiler(const std::string& traceFile, uint32_t maxEvents = DefaultMaxEvents);
+
+    struct Scope final {
+      Scope(ScriptProfiler* p, size_t sym, const char* name):p(p) { if(p!=nullptr) p->enter(sym,name); }
+      Scope(const Scope&)=delete;
+      ~Scope() { if(p!=nullptr) p->leave(); }
+      ScriptProfiler* p;
+      };
+
+    struct Stat final {
+      std::string name;
+      uint64_t    calls=0;
+      uint64_t    incl =0; // ns
+      uint64_t    excl =0; // ns
+      uint32_t    active=0;
+      };
+
+    void enter(size_t sym, const char* name);
+    void leave();
+
+    const Stat* stats(size_t sym) const;
+
+    void report() const;
+    bool writeTrace() const;
+
+    const std::string& traceFileName() const { return traceFile; }
+
+  private:
+    struct Frame final {
+      size_t      sym  =0;
+      uint64_t    start=0;
+      uint64_t    child=0;
+      };
+
+    struct Event final {
+      size_t      sym  =0;
+      uint64_t    start=0;
+      uint64_t    dur  =0;
+      uint32_t    depth=0;
+      };
+
+    uint64_t now() const;
+    static std::string sessionFile(const std::string& traceFile);
+
+    std::string                     traceFile;
+    uint32_t                        maxEvents=0;
+    uint64_t                        epoch=0;
+    std::unordered_map<size_t,Stat> stat;
+    std::vector<Frame>              stack;
+    std::vector<Event>              events;
+  };
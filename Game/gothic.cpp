@@ -5,6 +5,8 @@
 
 #include <zenload/zCMesh.h>
 #include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
 #include "game/definitions/visualfxdefinitions.h"
 #include "game/definitions/sounddefinitions.h"
@@ -17,6 +19,7 @@
 #include "utils/installdetect.h"
 #include "utils/fileutil.h"
 #include "utils/inifile.h"
+#include "utils/tracer.h"
 
 using namespace Tempest;
 
@@ -51,6 +54,29 @@ Gothic::Gothic(const int argc, const char **argv){
     else if(std::strcmp(argv[i],"-nomenu")==0){
       noMenu=true;
       }
+    else if(std::strcmp(argv[i],"-cook")==0){
+      isCook=true;
+      }
+    else if(std::strcmp(argv[i],"-benchmark")==0){
+      ++i;
+      if(i<argc)
+        benchTicks=uint32_t(std::max(0,std::atoi(argv[i])));
+      }
+    else if(std::strcmp(argv[i],"-scriptprof")==0){
+      isScriptProf=true;
+      }
+    else if(std::strcmp(argv[i],"-scriptprof-trace")==0){
+      ++i;
+      if(i<argc) {
+        isScriptProf=true;
+        scriptTrace=argv[i];
+        }
+      }
+    else if(std::strcmp(argv[i],"-scriptprof-events")==0){
+      ++i;
+      if(i<argc)
+        scriptTraceMax=uint32_t(std::max(0,std::atoi(argv[i])));
+      }
     else if(std::strcmp(argv[i],"-rambo")==0){
       isRambo=true;
       }
@@ -89,7 +115,7 @@ Gothic::Gothic(const int argc, const char **argv){
     vinfo.patch = baseIniFile->getI("GAME","PATCHVERSION");
     }
 
-  fight      .reset(new FightAi(*this));
+  fight      .reset(new FightAi(*createVm(u"Fight.dat")));
   camera     .reset(new CameraDefinitions(*this));
   soundDef   .reset(new SoundDefinitions(*this));
   particleDef.reset(new ParticlesDefinitions(*this));
@@ -217,6 +243,22 @@ const ParticleFx* Gothic::loadParticleFx(const char *name) {
   return particleDef->get(name);
   }
 
+void Gothic::prefetchFx(const std::vector<std::string>& vfx, std::vector<std::string> pfx, bool newWorld) {
+  if(newWorld) {
+    // lazy loads are reported only relative to warmup of current world
+    vfxDef     ->beginWarmup();
+    particleDef->beginWarmup();
+    }
+  vfxDef->prefetch(vfx,pfx);
+  std::sort(pfx.begin(),pfx.end());
+  pfx.erase(std::unique(pfx.begin(),pfx.end()),pfx.end());
+  particleDef->prefetch(pfx);
+  }
+
+size_t Gothic::fxLateLoads() const {
+  return vfxDef->lateLoads() + particleDef->lateLoads();
+  }
+
 void Gothic::emitGlobalSound(const char *sfx) {
   emitGlobalSound(loadSoundFx(sfx));
   }
@@ -305,6 +347,7 @@ bool Gothic::finishLoading() {
     if(pendingGame!=nullptr)
       game = std::move(pendingGame);
     saveTex = Texture2d();
+    Resources::trimCache();
     onWorldLoaded();
     return true;
     }
@@ -337,6 +380,8 @@ void Gothic::implStartLoadSave(const char* banner,
   auto g = clearGame().release();
   try{
     auto l = std::thread([this,f,g,one]() noexcept {
+      TRACE_THREAD("loader");
+      TRACE_ZONE("Gothic::load");
       std::unique_ptr<GameSession> game(g);
       std::unique_ptr<GameSession> next;
       auto curState = one;
@@ -10,6 +10,7 @@
 #include <daedalus/DaedalusVM.h>
 
 #include "game/gamesession.h"
+#include "game/scriptprofiler.h"
 #include "world/world.h"
 #include "ui/documentmenu.h"
 #include "ui/chapterscreen.h"
@@ -41,7 +42,12 @@ class Gothic final {
     auto version() const -> const VersionInfo&;
 
     bool isInGame() const;
-    bool doStartMenu() const { return !noMenu; }
+    bool doStartMenu()     const { return !noMenu; }
+    bool doCook()          const { return isCook; }
+    bool doScriptProfile() const { return isScriptProf; }
+    auto benchmarkTicks()  const -> uint32_t { return benchTicks; }
+    auto scriptTraceFile() const -> const std::string& { return scriptTrace; }
+    auto scriptTraceEvents() const -> uint32_t { return scriptTraceMax; }
 
     void         setGame(std::unique_ptr<GameSession> &&w);
     auto         clearGame() -> std::unique_ptr<GameSession>;
@@ -61,6 +67,8 @@ class Gothic final {
 
     auto      loadParticleFx(const char* name) -> const ParticleFx*;
     auto      loadVisualFx  (const char* name) -> const VisualFx*;
+    void      prefetchFx    (const std::vector<std::string>& vfx, std::vector<std::string> pfx, bool newWorld);
+    size_t    fxLateLoads() const;
 
     void      emitGlobalSound(const char*        sfx);
     void      emitGlobalSound(const std::string& sfx);
@@ -83,6 +91,9 @@ class Gothic final {
     void      startSave(Tempest::Texture2d&& tex, const std::function<std::unique_ptr<GameSession>(std::unique_ptr<GameSession>&&)> f);
     void      cancelLoading();
 
+    // fixed simulation step, ms; shared by game loop and benchmark
+    static constexpr uint64_t TickStep = 10;
+
     void      tick(uint64_t dt);
 
     void      updateAnimation();
@@ -148,8 +159,13 @@ class Gothic final {
     std::u16string                          gpath, gscript;
     std::string                             wdef;
     std::string                             saveDef;
+    std::string                             scriptTrace;
     bool                                    noMenu=false;
     bool                                    isWindow=false;
+    bool                                    isCook=false;
+    bool                                    isScriptProf=false;
+    uint32_t                                scriptTraceMax=ScriptProfiler::DefaultMaxEvents;
+    uint32_t                                benchTicks=0;
     uint16_t                                pauseSum=0;
     bool                                    isDebug=false;
     bool                                    isRambo=false;
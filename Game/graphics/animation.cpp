@@ -5,6 +5,7 @@
 #include <zenload/modelAnimationParser.h>
 #include <zenload/zCModelPrototype.h>
 #include <zenload/zenParser.h>
+#include <unordered_set>
 
 #include "world/npc.h"
 #include "resources.h"
@@ -180,6 +181,22 @@ void Animation::debug() const {
     Log::d(i.name);
   }
 
+size_t Animation::memoryUsage() const {
+  // aliases share frames with original sequence
+  std::unordered_set<const AnimData*> counted;
+  size_t sz = sequences.size()*sizeof(Sequence);
+  for(auto& i:sequences) {
+    auto& d = i.data;
+    if(d==nullptr || !counted.insert(d.get()).second)
+      continue;
+    sz += sizeof(AnimData);
+    sz += d->samples.size()*sizeof(ZenLoad::zCModelAniSample);
+    sz += d->nodeIndex.size()*sizeof(uint32_t);
+    sz += d->tr.size()*sizeof(ZMath::float3);
+    }
+  return sz;
+  }
+
 Animation::Sequence& Animation::loadMAN(const std::string& name) {
   sequences.emplace_back(name);
   auto& ret = sequences.back();
@@ -247,8 +264,8 @@ Animation::Sequence::Sequence(const std::string &fname) {
   if(!Resources::hasFile(fname))
     return;
 
-  const VDFS::FileIndex& idx = Resources::vdfsIndex();
-  ZenLoad::ZenParser            zen(fname,idx);
+  auto                          buf = Resources::getFileData(fname);
+  ZenLoad::ZenParser            zen(buf.data(),buf.size());
   ZenLoad::ModelAnimationParser p(zen);
 
   data = std::make_shared<AnimData>();
@@ -105,6 +105,7 @@ class Animation final {
     const Sequence *sequence(const char* name) const;
     const Sequence *sequenceAsc(const char* name) const;
     void            debug() const;
+    size_t          memoryUsage() const;
 
   private:
     Sequence& loadMAN(const std::string &name);
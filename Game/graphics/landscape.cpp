@@ -52,12 +52,14 @@ Landscape::Landscape(const RendererStorage &storage, const PackedMesh &mesh)
 void Landscape::setMatrix(uint32_t frameId, const Matrix4x4 &mat, const Matrix4x4 *sh, size_t shCount) {
   assert(shCount==2);
 
-  uboCpu.mvp    = mat;
-  uboCpu.shadow = sh[1];
+  uboCpu.mvp     = mat;
+  uboCpu.shadow  = sh[1];
+  uboCpu.shadow1 = sh[1];
   pf[frameId].uboGpu[1].update(&uboCpu,0,1);
 
-  uboCpu.mvp    = mat;
-  uboCpu.shadow = sh[0];
+  uboCpu.mvp     = mat;
+  uboCpu.shadow  = sh[0];
+  uboCpu.shadow1 = sh[1];
   pf[frameId].uboGpu[0].update(&uboCpu,0,1);
   }
 
@@ -36,6 +36,7 @@ class Landscape final {
       Tempest::Matrix4x4  shadow;
       std::array<float,4> lightAmb={{0,0,0}};
       std::array<float,4> lightCl ={{1,1,1}};
+      Tempest::Matrix4x4  shadow1;
       };
 
     struct PerFrame {
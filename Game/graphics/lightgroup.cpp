@@ -0,0 +1,23 @@
+#include "lightgroup.h"
+
+using namespace Tempest;
+
+LightGroup::LightGroup() {
+  }
+
+void LightGroup::add(const ZenLoad::zCVobData& vob) {
+  auto& l  = vob.zCVobLight;
+  auto  cl = l.color; // ARGB
+
+  Source src;
+  src.pos   = Vec3(vob.position.x,vob.position.y,vob.position.z);
+  src.color = Vec3(float((cl>>16)&0xFF)/255.f, float((cl>>8)&0xFF)/255.f, float(cl&0xFF)/255.f);
+  src.range = l.range;
+  add(src);
+  }
+
+void LightGroup::add(const Source& src) {
+  if(src.range<=0)
+    return;
+  light.push_back(src);
+  }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Tempest/Point>
+#include <zenload/zTypes.h>
+
+#include <vector>
+
+class LightGroup final {
+  public:
+    LightGroup();
+
+    struct Source final {
+      Tempest::Vec3 pos;
+      Tempest::Vec3 color;
+      float         range=0;
+      };
+
+    void   add(const ZenLoad::zCVobData& vob);
+    void   add(const Source& src);
+    size_t size() const { return light.size(); }
+
+    const std::vector<Source>& lights() const { return light; }
+
+  private:
+    std::vector<Source> light;
+  };
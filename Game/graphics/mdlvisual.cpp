@@ -41,13 +41,29 @@ void MdlVisual::setPos(float x, float y, float z) {
 void MdlVisual::setPos(const Tempest::Matrix4x4 &m) {
   // TODO: deferred setObjMatrix
   pos = m;
-  head   .setObjMatrix(pos);
-  sword  .setObjMatrix(pos);
-  bow    .setObjMatrix(pos);
+  auto p = renderPos();
+  head   .setObjMatrix(p);
+  sword  .setObjMatrix(p);
+  bow    .setObjMatrix(p);
   for(auto& i:item)
-    i.setObjMatrix(pos);
-  pfx    .setObjMatrix(pos);
-  view   .setObjMatrix(pos);
+    i.setObjMatrix(p);
+  pfx    .setObjMatrix(p);
+  view   .setObjMatrix(p);
+  }
+
+void MdlVisual::setRenderShift(const Vec3& s) {
+  if(s.x==renderShift.x && s.y==renderShift.y && s.z==renderShift.z)
+    return;
+  renderShift = s;
+  setPos(pos);
+  }
+
+Matrix4x4 MdlVisual::renderPos() const {
+  auto p = pos;
+  p.set(3,0,pos.at(3,0)+renderShift.x);
+  p.set(3,1,pos.at(3,1)+renderShift.y);
+  p.set(3,2,pos.at(3,2)+renderShift.z);
+  return p;
   }
 
 // mdl_setvisual
@@ -220,15 +236,16 @@ void MdlVisual::updateAnimation(Npc& npc,int comb) {
   solver.update(tickCount);
   pose.update(solver,comb,tickCount);
 
-  head      .setSkeleton(pose,pos);
-  sword     .setSkeleton(pose,pos);
-  bow       .setSkeleton(pose,pos);
-  ammunition.setSkeleton(pose,pos);
-  stateItm  .setSkeleton(pose,pos);
+  auto p = renderPos();
+  head      .setSkeleton(pose,p);
+  sword     .setSkeleton(pose,p);
+  bow       .setSkeleton(pose,p);
+  ammunition.setSkeleton(pose,p);
+  stateItm  .setSkeleton(pose,p);
   for(auto& i:item)
-    i.setSkeleton(pose,pos);
-  pfx .setSkeleton(pose,pos);
-  view.setSkeleton(pose,pos);
+    i.setSkeleton(pose,p);
+  pfx .setSkeleton(pose,p);
+  view.setSkeleton(pose,p);
   }
 
 Vec3 MdlVisual::mapBone(const char* b) const {
@@ -22,6 +22,8 @@ class MdlVisual final {
 
     void                           setPos(float x,float y,float z);
     void                           setPos(const Tempest::Matrix4x4 &m);
+    // offset of displayed model from simulated position; used for interpolation between simulation steps
+    void                           setRenderShift(const Tempest::Vec3& s);
     void                           setVisual(const Skeleton *visual);
     void                           setVisualBody(MeshObjects::Mesh &&h, MeshObjects::Mesh &&body);
 
@@ -72,7 +74,10 @@ class MdlVisual final {
     uint32_t                       comboLength() const;
 
   private:
+    Tempest::Matrix4x4             renderPos() const;
+
     Tempest::Matrix4x4             pos;
+    Tempest::Vec3                  renderShift;
     MeshObjects::Mesh              head;
     MeshObjects::Mesh              view;
     MeshObjects::Mesh              sword, bow;
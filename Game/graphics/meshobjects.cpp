@@ -20,6 +20,7 @@ MeshObjects::MeshObjects(const RendererStorage &storage)
 
   uboGlobal.modelView.identity();
   uboGlobal.shadowView.identity();
+  uboGlobal.shadowView1.identity();
   }
 
 bool MeshObjects::needToUpdateCommands(uint8_t fId) const {
@@ -45,9 +46,15 @@ void MeshObjects::setAsUpdated(uint8_t fId) {
 void MeshObjects::setModelView(const Tempest::Matrix4x4 &m, const Tempest::Matrix4x4 *sh, size_t shCount) {
   assert(shCount==2);
 
-  uboGlobal.modelView  = m;
-  uboGlobal.shadowView = sh[0];
-  shadowView1          = sh[1];
+  uboGlobal.modelView   = m;
+  uboGlobal.shadowView  = sh[0];
+  uboGlobal.shadowView1 = sh[1];
+  }
+
+void MeshObjects::setShadowView(const Tempest::Matrix4x4* sh, size_t shCount) {
+  // skinned meshes have no bounds in model space, so only static buckets are culled per cascade
+  for(auto& c:chunksSt)
+    c.setShadowView(sh,shCount);
   }
 
 void MeshObjects::setLight(const Light &l,const Tempest::Vec3& ambient) {
@@ -84,7 +91,7 @@ ObjectsBucket<MeshObjects::UboDn,Resources::VertexA> &MeshObjects::getBucketDn(c
 MeshObjects::Item MeshObjects::implGet(const StaticMesh &mesh, const Tempest::Texture2d *mat,
                                        const Tempest::IndexBuffer<uint32_t>& ibo) {
   auto&        bucket = getBucketSt(mat);
-  const size_t id     = bucket.alloc(mesh.vbo,ibo);
+  const size_t id     = bucket.alloc(mesh.vbo,ibo,mesh.bsCenter,mesh.bsRadius);
   return Item(bucket,id);
   }
 
@@ -163,7 +170,7 @@ void MeshObjects::updateUbo(uint8_t fId) {
   uboGlobalPf[0].update(uboGlobal,fId);
 
   auto ubo2 = uboGlobal;
-  ubo2.shadowView = shadowView1;
+  ubo2.shadowView = uboGlobal.shadowView1;
   uboGlobalPf[1].update(ubo2,fId);
   }
 
@@ -85,6 +85,7 @@ class MeshObjects final {
     void setAsUpdated(uint8_t imgId);
 
     void setModelView(const Tempest::Matrix4x4& m, const Tempest::Matrix4x4 *sh, size_t shCount);
+    void setShadowView(const Tempest::Matrix4x4 *sh, size_t shCount);
     void setLight(const Light &l, const Tempest::Vec3 &ambient);
 
   private:
@@ -98,6 +99,7 @@ class MeshObjects final {
       Tempest::Matrix4x4            shadowView;
       std::array<float,4>           lightAmb={{0,0,0}};
       std::array<float,4>           lightCl ={{1,1,1}};
+      Tempest::Matrix4x4            shadowView1;
       };
 
     struct UboSt final {
@@ -126,7 +128,6 @@ class MeshObjects final {
 
     UboChain<UboGlobal,void>        uboGlobalPf[2];
     UboGlobal                       uboGlobal;
-    Tempest::Matrix4x4              shadowView1;
 
     ObjectsBucket<UboSt,Vertex>&    getBucketSt(const Tempest::Texture2d* mat);
     ObjectsBucket<UboSt,Vertex>&    getBucketAt(const Tempest::Texture2d* mat);
@@ -4,9 +4,13 @@
 #include <Tempest/UniformBuffer>
 #include <Tempest/Log>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
 #include "abstractobjectsbucket.h"
+#include "shadowcascades.h"
 #include "ubostorage.h"
 #include "resources.h"
 
@@ -36,8 +40,13 @@ class ObjectsBucket : public AbstractObjectsBucket {
     Tempest::Uniforms&          uboShadow(size_t imgId,int layer) { return pf[imgId].uboSh[layer]; }
 
     size_t                      alloc(const Tempest::VertexBuffer<Vertex> &vbo, const Tempest::IndexBuffer<uint32_t> &ibo);
+    // static objects with bounding sphere are culled per shadow cascade; others are drawn into every cascade
+    size_t                      alloc(const Tempest::VertexBuffer<Vertex> &vbo, const Tempest::IndexBuffer<uint32_t> &ibo,
+                                      const Tempest::Vec3& bsCenter, float bsRadius);
     void                        free(size_t i) override;
 
+    void                        setShadowView(const Tempest::Matrix4x4* sh, size_t shCount);
+
     void                        draw      (Tempest::Encoder<Tempest::CommandBuffer> &cmd,const Tempest::RenderPipeline &pipeline, uint32_t imgId);
     void                        drawShadow(Tempest::Encoder<Tempest::CommandBuffer> &cmd,const Tempest::RenderPipeline &pipeline, uint32_t imgId, int layer);
 
@@ -47,19 +56,29 @@ class ObjectsBucket : public AbstractObjectsBucket {
     void                        setAsUpdated(uint8_t fId);
 
   private:
+    enum { SHADOW_LAYERS=2 };
+
     struct NonUbo final {
       const Tempest::VertexBuffer<Vertex>*  vbo=nullptr;
       const Tempest::IndexBuffer<uint32_t>* ibo=nullptr;
       size_t                                ubo=size_t(-1);
+      Tempest::Vec3                         bsCenter;      // model space
+      float                                 bsRadius=-1.f; // negative - no culling
+      Tempest::Vec3                         wCenter;       // world space
+      float                                 wRadius=-1.f;
       };
 
     struct PerFrame final {
-      Tempest::Uniforms ubo, uboSh[2];
-      bool              nToUpdate=true; //invalidate cmd buffers
+      Tempest::Uniforms    ubo, uboSh[SHADOW_LAYERS];
+      bool                 nToUpdate=true; //invalidate cmd buffers
+      std::vector<uint8_t> shRecorded;     // per object: mask of cascades, that have it in cmd buffer
       };
 
     const Tempest::Texture2d*   tex=nullptr;
     UboStorage<Ubo>&            uStorage;
+    Tempest::Matrix4x4          shadowView[SHADOW_LAYERS];
+    bool                        hasShadowView=false;
+    bool                        shadowMoved=true; // culled object moved since last check of recorded cascades
 
     std::unique_ptr<PerFrame[]> pf;
     size_t                      pfSize=0;
@@ -75,6 +94,7 @@ class ObjectsBucket : public AbstractObjectsBucket {
     void                        invalidate();
     static bool                 idxCmp(const NonUbo* a,const NonUbo* b);
     void                        mkIndex();
+    bool                        isShadowVisible(const NonUbo& d, int layer, float margin) const;
 
     void                        setObjMatrix(size_t i,const Tempest::Matrix4x4& m) override;
     void                        setSkeleton(size_t i,const Skeleton* sk) override;
@@ -96,6 +116,18 @@ size_t ObjectsBucket<Ubo,Vertex>::getNextId(){
 template<class Ubo, class Vertex>
 void ObjectsBucket<Ubo,Vertex>::setObjMatrix(size_t i, const Tempest::Matrix4x4 &m) {
   element(i).setObjMatrix(m);
+
+  auto& d = data[i];
+  if(d.bsRadius<0)
+    return;
+  auto c = d.bsCenter;
+  m.project(c.x,c.y,c.z);
+  float sc = 0;
+  for(int k=0;k<3;++k)
+    sc = std::max(sc,m.at(k,0)*m.at(k,0) + m.at(k,1)*m.at(k,1) + m.at(k,2)*m.at(k,2));
+  d.wCenter = c;
+  d.wRadius = d.bsRadius*std::sqrt(sc);
+  shadowMoved = true;
   }
 
 template<class Ubo, class Vertex>
@@ -119,6 +151,61 @@ size_t ObjectsBucket<Ubo,Vertex>::alloc(const Tempest::VertexBuffer<Vertex>  &vb
   return id;
   }
 
+template<class Ubo,class Vertex>
+size_t ObjectsBucket<Ubo,Vertex>::alloc(const Tempest::VertexBuffer<Vertex>  &vbo,
+                                        const Tempest::IndexBuffer<uint32_t> &ibo,
+                                        const Tempest::Vec3& bsCenter, float bsRadius) {
+  const size_t id = alloc(vbo,ibo);
+  data[id].bsCenter = bsCenter;
+  data[id].bsRadius = bsRadius;
+  // position is unknown until setObjMatrix
+  data[id].wRadius  = -1.f;
+  return id;
+  }
+
+template<class Ubo,class Vertex>
+void ObjectsBucket<Ubo,Vertex>::setShadowView(const Tempest::Matrix4x4* sh, size_t shCount) {
+  bool same = hasShadowView && !shadowMoved;
+  for(size_t i=0;i<SHADOW_LAYERS && i<shCount;++i) {
+    if(std::memcmp(&shadowView[i],&sh[i],sizeof(Tempest::Matrix4x4))!=0)
+      same = false;
+    shadowView[i] = sh[i];
+    }
+  hasShadowView = true;
+  // same cascades and no moves: buffers, recorded since last check, have everything visible
+  if(same)
+    return;
+  shadowMoved = false;
+
+  // command buffers are recorded with margin around cascade: re-record only once object, missing there, becomes visible
+  for(size_t f=0;f<pfSize;++f) {
+    auto& frame = pf[f];
+    if(frame.nToUpdate)
+      continue;
+    if(frame.shRecorded.size()!=data.size()) {
+      frame.nToUpdate = true;
+      continue;
+      }
+    for(size_t i=0;i<data.size() && !frame.nToUpdate;++i) {
+      auto& d = data[i];
+      if(d.vbo==nullptr || d.wRadius<0)
+        continue;
+      for(int layer=0;layer<SHADOW_LAYERS;++layer)
+        if((frame.shRecorded[i]&(1<<layer))==0 && isShadowVisible(d,layer,0.f)) {
+          frame.nToUpdate = true;
+          break;
+          }
+      }
+    }
+  }
+
+template<class Ubo,class Vertex>
+bool ObjectsBucket<Ubo,Vertex>::isShadowVisible(const NonUbo& d, int layer, float margin) const {
+  if(d.wRadius<0 || !hasShadowView)
+    return true;
+  return ShadowCascades::isVisible(shadowView[layer],d.wCenter,d.wRadius,margin);
+  }
+
 template<class Ubo, class Vertex>
 void ObjectsBucket<Ubo,Vertex>::free(size_t i) {
   invalidate();
@@ -160,11 +247,20 @@ template<class Ubo,class Vertex>
 void ObjectsBucket<Ubo,Vertex>::drawShadow(Tempest::Encoder<Tempest::CommandBuffer> &cmd,const Tempest::RenderPipeline &pipeline, uint32_t imgId, int layer) {
   mkIndex();
 
+  // margin of 1/8 of cascade width, so moving camera doesn't re-record buffers every frame
+  const float margin = 0.25f;
+
   auto& frame = pf[imgId];
+  frame.shRecorded.resize(data.size());
   for(size_t i=0;i<index.size();++i){
-    auto& di = *index[i];
-    if(di.vbo==nullptr)
+    auto&        di  = *index[i];
+    const size_t id  = size_t(index[i]-data.data());
+    const auto   bit = uint8_t(1<<layer);
+    if(di.vbo==nullptr || !isShadowVisible(di,layer,margin)) {
+      frame.shRecorded[id] = uint8_t(frame.shRecorded[id] & ~bit);
       continue;
+      }
+    frame.shRecorded[id] = uint8_t(frame.shRecorded[id] | bit);
     uint32_t offset = uint32_t(di.ubo);
 
     cmd.setUniforms(pipeline,frame.uboSh[layer],1,&offset);
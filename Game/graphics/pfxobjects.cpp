@@ -7,6 +7,8 @@
 #include "pose.h"
 #include "rendererstorage.h"
 #include "skeleton.h"
+#include "utils/framebudget.h"
+#include "utils/tracer.h"
 
 using namespace Tempest;
 
@@ -252,8 +254,9 @@ PfxObjects::Emitter PfxObjects::get(const ParticleFx &decl) {
   }
 
 void PfxObjects::setModelView(const Tempest::Matrix4x4 &m,const Tempest::Matrix4x4 &shadow) {
-  uboGlobal.modelView  = m;
-  uboGlobal.shadowView = shadow;
+  uboGlobal.modelView   = m;
+  uboGlobal.shadowView  = shadow;
+  uboGlobal.shadowView1 = shadow; // not sampled by particles
   }
 
 void PfxObjects::setLight(const Light &l, const Vec3 &ambient) {
@@ -277,6 +280,7 @@ void PfxObjects::updateUbo(uint8_t frameId, uint64_t ticks) {
   uboGlobalPf.update(uboGlobal,frameId);
   uint64_t dt = ticks-lastUpdate;
 
+  FrameBudget::Scope scope(FrameBudget::T_Particles);
   for(auto& i:bucket) {
     if(dt!=0) {
       tickSys(i,dt);
@@ -318,6 +322,10 @@ void PfxObjects::draw(Tempest::Encoder<Tempest::CommandBuffer> &cmd, uint32_t im
     }
   }
 
+void PfxObjects::seed(uint32_t s) {
+  rndEngine.seed(s);
+  }
+
 float PfxObjects::randf() {
   return float(rndEngine()%10000)/10000.f;
   }
@@ -331,7 +339,10 @@ PfxObjects::Bucket &PfxObjects::getBucket(const ParticleFx &ow) {
   }
 
 void PfxObjects::tickSys(PfxObjects::Bucket &b,uint64_t dt) {
-  float k = float(dt)/1000.f;
+  TRACE_ZONE("PfxObjects::tickSys");
+  float    k    = float(dt)/1000.f;
+  // under load, only every n-th particle is emitted
+  uint64_t step = uint64_t(1) << FrameBudget::inst().quality(FrameBudget::T_Particles);
 
   for(auto& p:b.block) {
     if(p.count>0) {
@@ -368,6 +379,8 @@ void PfxObjects::tickSys(PfxObjects::Bucket &b,uint64_t dt) {
       } else {
       while(p.emited<emited) {
         p.emited++;
+        if(p.emited%step!=0)
+          continue;
 
         for(size_t i=0;i<b.blockSize;++i) {
           ParState& ps = b.particles[i+p.offset];
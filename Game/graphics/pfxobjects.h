@@ -50,6 +50,7 @@ class PfxObjects final {
       };
 
     Emitter get(const ParticleFx& decl);
+    static void seed(uint32_t s);
 
     void    setModelView(const Tempest::Matrix4x4 &m, const Tempest::Matrix4x4 &shadow);
     void    setLight(const Light &l, const Tempest::Vec3 &ambient);
@@ -72,6 +73,7 @@ class PfxObjects final {
       Tempest::Matrix4x4            shadowView;
       std::array<float,4>           lightAmb={{0,0,0}};
       std::array<float,4>           lightCl ={{1,1,1}};
+      Tempest::Matrix4x4            shadowView1;
       };
 
     struct PerFrame final {
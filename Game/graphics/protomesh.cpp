@@ -190,6 +190,17 @@ Tempest::Matrix4x4 ProtoMesh::mapToRoot(size_t n) const {
   return m;
   }
 
+void ProtoMesh::textures(std::unordered_set<const Tempest::Texture2d*>& out) const {
+  for(auto& i:attach)
+    for(auto& s:i.sub)
+      if(s.texture!=nullptr)
+        out.insert(s.texture);
+  for(auto& i:skined)
+    for(auto& s:i.sub)
+      if(s.texture!=nullptr)
+        out.insert(s.texture);
+  }
+
 void ProtoMesh::setupScheme(const std::string &s) {
   auto sep = s.find("_");
   if(sep!=std::string::npos) {
@@ -5,6 +5,8 @@
 #include <Tempest/Device>
 #include <Tempest/Matrix4x4>
 
+#include <unordered_set>
+
 #include "graphics/submesh/staticmesh.h"
 #include "graphics/submesh/animmesh.h"
 
@@ -77,6 +79,7 @@ class ProtoMesh {
 
     size_t                         skinedNodesCount() const;
     Tempest::Matrix4x4             mapToRoot(size_t node) const;
+    void                           textures(std::unordered_set<const Tempest::Texture2d*>& out) const;
 
   private:
     void                           setupScheme(const std::string& s);
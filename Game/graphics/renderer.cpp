@@ -54,6 +54,7 @@ void Renderer::resetSwapchain() {
   zbuffer        = device.attachment(zBufferFormat,w,h);
   zbufferItem    = device.attachment(zBufferFormat,w,h);
   shadowMapFinal = device.attachment(shadowFormat,smSize,smSize);
+  shadow.setResolution(smSize);
 
   Sampler2d smp;
   smp.setClamping(ClampMode::ClampToBorder);
@@ -93,6 +94,7 @@ void Renderer::resetSwapchain() {
   }
 
 void Renderer::onWorldChanged() {
+  shadow.invalidate();
   if(auto wview=gothic.worldView()){
     if(zbuffer.w()>0 && zbuffer.h()>0)
       wview->initPipeline(uint32_t(zbuffer.w()),uint32_t(zbuffer.h()));
@@ -102,8 +104,7 @@ void Renderer::onWorldChanged() {
 void Renderer::setCameraView(const Camera& camera) {
   view = camera.view();
   if(auto wview=gothic.worldView()){
-    shadow[0] = camera.viewShadow(wview->mainLight().dir(),0);
-    shadow[1] = camera.viewShadow(wview->mainLight().dir(),1);
+    shadow.update(view,wview->projective(),wview->mainLight().dir());
     }
   }
 
@@ -123,10 +124,15 @@ void Renderer::draw(Encoder<PrimaryCommandBuffer> &cmd, FrameBuffer& fbo, const
     return;
     }
 
+  // cascade visibility of casters decides, if shadow cmd buffers have to be recorded again
+  wview->setShadowView(shadow.matrix(),ShadowCascades::CASCADES);
   wview->updateCmd(frameId,*gothic.world(),swapchain.frame(frameId),shadowMapFinal,fbo.layout(),fboShadow->layout());
-  wview->updateUbo(frameId,view,shadow,2);
+  wview->updateUbo(frameId,view,shadow.matrix(),ShadowCascades::CASCADES);
 
-  for(uint8_t i=0;i<2;++i) {
+  for(uint8_t i=0;i<ShadowCascades::CASCADES;++i) {
+    // near cascade has dynamic casters; far one is reused, while it still covers the view
+    if(i>0 && shadow.isStable(i))
+      continue;
     cmd.setPass(fboShadow[i],shadowPass);
     wview->drawShadow(cmd,swapchain.frameId(),i);
     }
@@ -11,6 +11,7 @@
 
 #include "worldview.h"
 #include "rendererstorage.h"
+#include "shadowcascades.h"
 
 class Gothic;
 class Camera;
@@ -37,7 +38,7 @@ class Renderer final {
     Tempest::Swapchain&               swapchain;
     Gothic&                           gothic;
     Tempest::Matrix4x4                view;
-    Tempest::Matrix4x4                shadow[2];
+    ShadowCascades                    shadow;
 
     Tempest::Attachment               zbuffer, zbufferItem;
     Tempest::Attachment               shadowMap[2], shadowZ[2], shadowMapFinal;
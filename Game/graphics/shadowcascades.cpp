@@ -0,0 +1,191 @@
+#include "shadowcascades.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Tempest;
+
+// all distances are in world units (cm)
+static const float shadowNear     = 50.f;
+static const float shadowFar      = 10000.f;
+static const float splitLambda    = 0.75f;
+static const float casterDepth    = 4000.f; // how far behind the slice (towards the sun) casters are kept
+static const float farPadding     = 1.15f;  // far cascades are fitted with spare room, so they can be reused
+static const float ldirThreshold  = 0.99999f;
+static const uint32_t maxAge      = 120;    // frames; catches changes of dynamic casters in far cascades
+
+static float dot(const Vec3& a, const Vec3& b) {
+  return a.x*b.x + a.y*b.y + a.z*b.z;
+  }
+
+static Vec3 cross(const Vec3& a, const Vec3& b) {
+  return Vec3(a.y*b.z-a.z*b.y, a.z*b.x-a.x*b.z, a.x*b.y-a.y*b.x);
+  }
+
+static Vec3 normalize(const Vec3& v) {
+  float l = std::sqrt(dot(v,v));
+  if(l<=0.f)
+    return v;
+  return Vec3(v.x/l,v.y/l,v.z/l);
+  }
+
+static Vec3 transform(const Matrix4x4& m, float x, float y, float z) {
+  float rx = m.at(0,0)*x + m.at(1,0)*y + m.at(2,0)*z + m.at(3,0);
+  float ry = m.at(0,1)*x + m.at(1,1)*y + m.at(2,1)*z + m.at(3,1);
+  float rz = m.at(0,2)*x + m.at(1,2)*y + m.at(2,2)*z + m.at(3,2);
+  float rw = m.at(0,3)*x + m.at(1,3)*y + m.at(2,3)*z + m.at(3,3);
+  if(rw!=0.f) {
+    rx/=rw; ry/=rw; rz/=rw;
+    }
+  return Vec3(rx,ry,rz);
+  }
+
+ShadowCascades::ShadowCascades(uint32_t smSize)
+  :smSize(smSize) {
+  for(auto& i:mat)
+    i.identity();
+  computeSplits();
+  }
+
+void ShadowCascades::setResolution(uint32_t sz) {
+  smSize = sz;
+  invalidate();
+  }
+
+void ShadowCascades::invalidate() {
+  for(auto& i:cascade)
+    i = Cascade();
+  }
+
+void ShadowCascades::computeSplits() {
+  // practical split scheme: blend of logarithmic and uniform distribution
+  split[0] = shadowNear;
+  for(size_t i=1;i<=CASCADES;++i) {
+    float k   = float(i)/float(CASCADES);
+    float lg  = shadowNear*std::pow(shadowFar/shadowNear,k);
+    float un  = shadowNear+(shadowFar-shadowNear)*k;
+    split[i]  = splitLambda*lg + (1.f-splitLambda)*un;
+    }
+  }
+
+void ShadowCascades::update(const Matrix4x4& view, const Matrix4x4& proj, const std::array<float,3>& sunDir) {
+  const Vec3                ld   = normalize(Vec3(sunDir[0],sunDir[1],sunDir[2]));
+  const std::array<float,3> ldir = {ld.x,ld.y,ld.z};
+  if(ldir[1]>=0.f) {
+    // sun is below horizon
+    for(size_t i=0;i<CASCADES;++i) {
+      mat[i].identity();
+      cascade[i] = Cascade();
+      }
+    return;
+    }
+
+  auto invView = view;
+  invView.inverse();
+  auto invVp = proj;
+  invVp.mul(view);
+  invVp.inverse();
+
+  // camera origin and corner rays of the frustum, in world space
+  static const float cx[4] = {-1, 1,-1, 1};
+  static const float cy[4] = {-1,-1, 1, 1};
+  Frustum frustum;
+  frustum.origin  = transform(invView,0,0,0);
+  frustum.forward = normalize(transform(invVp,0,0,0.5f) - frustum.origin);
+  for(int i=0;i<4;++i)
+    frustum.ray[i] = transform(invVp,cx[i],cy[i],0.5f) - frustum.origin;
+
+  for(size_t i=0;i<CASCADES;++i) {
+    auto&  c = cascade[i];
+    Sphere s = fitSlice(frustum,split[i],split[i+1]);
+    if(isReusable(c,s,ldir)) {
+      c.stable = true;
+      c.age++;
+      continue;
+      }
+
+    if(i>0)
+      s.radius *= farPadding;
+    c.bounds = s;
+    c.ldir   = ldir;
+    c.valid  = true;
+    c.stable = false;
+    c.age    = 0;
+    mat[i]   = mkMatrix(c.bounds,ldir);
+    }
+  }
+
+ShadowCascades::Sphere ShadowCascades::fitSlice(const Frustum& f, float d0, float d1) const {
+  Vec3 pt[8];
+  for(int i=0;i<4;++i) {
+    const Vec3& dir = f.ray[i];
+    float       k   = dot(dir,f.forward);
+    if(k<=0.f)
+      k = 1.f;
+    pt[i*2+0] = f.origin + dir*(d0/k);
+    pt[i*2+1] = f.origin + dir*(d1/k);
+    }
+
+  Sphere s;
+  for(auto& p:pt)
+    s.center = s.center + p;
+  s.center = s.center*(1.f/8.f);
+  for(auto& p:pt) {
+    Vec3 d = p - s.center;
+    s.radius = std::max(s.radius,std::sqrt(dot(d,d)));
+    }
+
+  // radius depends only on projection and split, quantize it so rounding noise won't change texel size
+  s.radius = std::ceil(s.radius/16.f)*16.f;
+  return s;
+  }
+
+bool ShadowCascades::isReusable(const Cascade& c, const Sphere& s, const std::array<float,3>& ldir) const {
+  if(!c.valid || c.age>=maxAge)
+    return false;
+  const float ld = c.ldir[0]*ldir[0] + c.ldir[1]*ldir[1] + c.ldir[2]*ldir[2];
+  if(ld<ldirThreshold)
+    return false;
+  Vec3 d = s.center - c.bounds.center;
+  return std::sqrt(dot(d,d))+s.radius <= c.bounds.radius;
+  }
+
+bool ShadowCascades::isVisible(const Matrix4x4& m, const Vec3& c, float r, float margin) {
+  for(int k=0;k<3;++k) {
+    const float v   = m.at(0,k)*c.x + m.at(1,k)*c.y + m.at(2,k)*c.z + m.at(3,k);
+    const float ext = r*std::sqrt(m.at(0,k)*m.at(0,k) + m.at(1,k)*m.at(1,k) + m.at(2,k)*m.at(2,k)) + margin;
+    const float lo  = (k==2) ? 0.f : -1.f;
+    if(v+ext<lo || v-ext>1.f)
+      return false;
+    }
+  return true;
+  }
+
+Matrix4x4 ShadowCascades::mkMatrix(const Sphere& s, const std::array<float,3>& ldir) const {
+  const Vec3 lz = Vec3(ldir[0],ldir[1],ldir[2]);
+  const Vec3 up = std::fabs(lz.y)<0.99f ? Vec3(0,1,0) : Vec3(1,0,0);
+  const Vec3 lx = normalize(cross(up,lz));
+  const Vec3 ly = cross(lz,lx);
+
+  const float r     = s.radius;
+  const float texel = (2.f*r)/float(smSize);
+
+  // snap the center to texel grid, so the shadow does not shimmer on camera movement
+  float cx = dot(s.center,lx);
+  float cy = dot(s.center,ly);
+  float cz = dot(s.center,lz);
+  cx = std::floor(cx/texel)*texel;
+  cy = std::floor(cy/texel)*texel;
+
+  const float back  = std::max(r,casterDepth);
+  const float depth = back + r;
+  const float z0    = cz - back;
+
+  Matrix4x4 m;
+  m.identity();
+  m.set(0,0, lx.x/r);  m.set(1,0, lx.y/r);  m.set(2,0, lx.z/r);  m.set(3,0, -cx/r);
+  m.set(0,1, ly.x/r);  m.set(1,1, ly.y/r);  m.set(2,1, ly.z/r);  m.set(3,1, -cy/r);
+  m.set(0,2, lz.x/depth); m.set(1,2, lz.y/depth); m.set(2,2, lz.z/depth); m.set(3,2, -z0/depth);
+  m.set(0,3, 0.f);     m.set(1,3, 0.f);     m.set(2,3, 0.f);     m.set(3,3, 1.f);
+  return m;
+  }
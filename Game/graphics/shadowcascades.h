@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Tempest/Matrix4x4>
+#include <Tempest/Point>
+#include <array>
+#include <cstdint>
+
+class ShadowCascades final {
+  public:
+    enum { CASCADES = 2 };
+
+    ShadowCascades(uint32_t smSize=2048);
+
+    void setResolution(uint32_t smSize);
+    void invalidate();
+
+    // fits every cascade to its slice of the camera frustum; 'view' and 'proj' define the camera
+    void update(const Tempest::Matrix4x4& view, const Tempest::Matrix4x4& proj, const std::array<float,3>& sunDir);
+
+    const Tempest::Matrix4x4* matrix() const { return mat; }
+    // cascade still contains its frustum slice and light did not turn - shadowmap from previous frames is reusable
+    bool                      isStable(size_t layer) const { return layer<CASCADES && cascade[layer].stable; }
+    float                     splitDistance(size_t layer) const { return split[layer+1]; }
+
+    // sphere touches light-space box of cascade matrix 'm'; 'margin' extends the box, in clip units
+    static bool               isVisible(const Tempest::Matrix4x4& m, const Tempest::Vec3& center, float radius, float margin=0.f);
+
+  private:
+    struct Sphere final {
+      Tempest::Vec3 center;
+      float         radius=0;
+      };
+
+    struct Frustum final {
+      Tempest::Vec3 origin;
+      Tempest::Vec3 forward;
+      Tempest::Vec3 ray[4];
+      };
+
+    struct Cascade final {
+      Sphere              bounds;
+      std::array<float,3> ldir={};
+      bool                valid =false;
+      bool                stable=false;
+      uint32_t            age   =0;
+      };
+
+    void   computeSplits();
+    Sphere fitSlice(const Frustum& f, float d0, float d1) const;
+    bool   isReusable(const Cascade& c, const Sphere& s, const std::array<float,3>& ldir) const;
+    auto   mkMatrix(const Sphere& s, const std::array<float,3>& ldir) const -> Tempest::Matrix4x4;
+
+    uint32_t           smSize=2048;
+    float              split[CASCADES+1]={};
+    Cascade            cascade[CASCADES];
+    Tempest::Matrix4x4 mat[CASCADES];
+  };
@@ -1,9 +1,13 @@
 #include "staticmesh.h"
 
+#include <algorithm>
+#include <cmath>
+
 StaticMesh::StaticMesh(const ZenLoad::PackedMesh &mesh) {
   static_assert(sizeof(Vertex)==sizeof(ZenLoad::WorldVertex),"invalid landscape vertex format");
   const Vertex* vert=reinterpret_cast<const Vertex*>(mesh.vertices.data());
   vbo = Resources::vbo<Vertex>(vert,mesh.vertices.size());
+  setBounds(vert,mesh.vertices.size());
 
   sub.resize(mesh.subMeshes.size());
   for(size_t i=0;i<mesh.subMeshes.size();++i){
@@ -30,6 +34,7 @@ StaticMesh::StaticMesh(const ZenLoad::PackedSkeletalMesh &mesh) {
     cvbo[i].pos[2]  = mesh.vertices[i].LocalPositions[0].z;
     }
   vbo = Resources::vbo<Vertex>(cvbo.data(),cvbo.size());
+  setBounds(cvbo.data(),cvbo.size());
 
   sub.resize(mesh.subMeshes.size());
   for(size_t i=0;i<mesh.subMeshes.size();++i){
@@ -41,6 +46,7 @@ StaticMesh::StaticMesh(const ZenLoad::PackedSkeletalMesh &mesh) {
 
 StaticMesh::StaticMesh(const std::string& fname, std::vector<Resources::Vertex> cvbo, std::vector<uint32_t> ibo) {
   vbo = Resources::vbo<Vertex>(cvbo.data(),cvbo.size());
+  setBounds(cvbo.data(),cvbo.size());
   sub.resize(1);
   for(size_t i=0;i<1;++i){
     sub[i].texName = fname;
@@ -49,3 +55,21 @@ StaticMesh::StaticMesh(const std::string& fname, std::vector<Resources::Vertex>
     sub[i].ibo     = Resources::ibo(ibo.data(),ibo.size());
     }
   }
+
+void StaticMesh::setBounds(const Vertex* v, size_t count) {
+  if(count==0)
+    return;
+  float bmin[3] = {v[0].pos[0],v[0].pos[1],v[0].pos[2]};
+  float bmax[3] = {bmin[0],bmin[1],bmin[2]};
+  for(size_t i=1;i<count;++i)
+    for(int r=0;r<3;++r) {
+      bmin[r] = std::min(bmin[r],v[i].pos[r]);
+      bmax[r] = std::max(bmax[r],v[i].pos[r]);
+      }
+  bsCenter = Tempest::Vec3((bmin[0]+bmax[0])*0.5f,(bmin[1]+bmax[1])*0.5f,(bmin[2]+bmax[2])*0.5f);
+  for(size_t i=0;i<count;++i) {
+    Tempest::Vec3 d(v[i].pos[0]-bsCenter.x,v[i].pos[1]-bsCenter.y,v[i].pos[2]-bsCenter.z);
+    bsRadius = std::max(bsRadius,d.quadLength());
+    }
+  bsRadius = std::sqrt(bsRadius);
+  }
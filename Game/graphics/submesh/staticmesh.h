@@ -23,4 +23,9 @@ class StaticMesh {
 
     Tempest::VertexBuffer<Vertex>  vbo;
     std::vector<SubMesh>           sub;
+    Tempest::Vec3                  bsCenter;      // bounding sphere, in model space
+    float                          bsRadius=0;
+
+  private:
+    void                           setBounds(const Vertex* v, size_t count);
   };
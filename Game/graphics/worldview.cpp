@@ -8,6 +8,9 @@
 
 using namespace Tempest;
 
+static const float zNear = 0.05f;
+static const float zFar  = 100.0f;
+
 WorldView::WorldView(const World &world, const PackedMesh &wmesh, const RendererStorage &storage)
   :owner(world),storage(storage),sky(storage),land(storage,wmesh),
     vobGroup(storage),objGroup(storage),itmGroup(storage),decGroup(storage),pfxGroup(storage) {
@@ -28,7 +31,7 @@ WorldView::~WorldView() {
   }
 
 void WorldView::initPipeline(uint32_t w, uint32_t h) {
-  proj.perspective(45.0f, float(w)/float(h), 0.05f, 100.0f);
+  proj.perspective(45.0f, float(w)/float(h), zNear, zFar);
   vpWidth  = w;
   vpHeight = h;
   invalidateCmd();
@@ -54,18 +57,30 @@ void WorldView::setupSunDir(float pulse,float ang) {
   sun.setDir(std::cos(a),std::min(0.9f,-1.0f*pulse),std::sin(a));
   }
 
+// execution order of the single-buffer renderer: dynamic buffer (npc objects in main pass,
+// vobs in detail shadow) went first, so early-z is filled by the same geometry as before
+const WorldView::Group WorldView::shadowOrder[2][4] = {
+  {G_Vob, G_Land,G_Obj,G_Itm},
+  {G_Land,G_Vob, G_Obj,G_Itm},
+  };
+const WorldView::Group WorldView::mainOrder[G_Count] = {
+  G_Obj,G_Land,G_Vob,G_Itm,G_Dec,G_Sky,G_Pfx
+  };
+
 void WorldView::drawShadow(Encoder<PrimaryCommandBuffer> &cmd, uint8_t fId, uint8_t layer) {
-  if(!frame[fId].actual)
-    return;
-  cmd.exec(frame[fId].cmdShadowDyn[layer]);
-  cmd.exec(frame[fId].cmdShadow   [layer]);
+  auto& pf = frame[fId];
+  for(auto i:shadowOrder[layer]) {
+    if(pf.actual[i] && hasShadow(i,layer))
+      cmd.exec(pf.cmdShadow[layer][i]);
+    }
   }
 
 void WorldView::drawMain(Encoder<PrimaryCommandBuffer> &cmd, uint8_t fId) {
-  if(!frame[fId].actual)
-    return;
-  cmd.exec(frame[fId].cmdMainDyn);
-  cmd.exec(frame[fId].cmdMain);
+  auto& pf = frame[fId];
+  for(auto i:mainOrder) {
+    if(pf.actual[i])
+      cmd.exec(pf.cmdMain[i]);
+    }
   }
 
 MeshObjects::Mesh WorldView::getView(const char* visual, int32_t headTex, int32_t teethTex, int32_t bodyColor) {
@@ -97,6 +112,17 @@ PfxObjects::Emitter WorldView::getView(const ParticleFx *decl) {
   return PfxObjects::Emitter();
   }
 
+void WorldView::addLight(const ZenLoad::zCVobData& vob) {
+  pointLights.add(vob);
+  }
+
+void WorldView::setShadowView(const Tempest::Matrix4x4* shadow, size_t shCount) {
+  vobGroup.setShadowView(shadow,shCount);
+  objGroup.setShadowView(shadow,shCount);
+  itmGroup.setShadowView(shadow,shCount);
+  decGroup.setShadowView(shadow,shCount);
+  }
+
 void WorldView::updateLight() {
   const int64_t rise     = gtime(3,1).toInt();
   const int64_t meridian = gtime(11,46).toInt();
@@ -134,24 +160,47 @@ void WorldView::resetCmd() {
   storage.device.waitIdle();
   uint32_t count = storage.device.maxFramesInFlight();
   for(uint32_t i=0;i<count;++i) {
-    frame[i].actual=false;
+    for(auto& a:frame[i].actual)
+      a = false;
+    }
+  }
+
+bool WorldView::hasShadow(Group g, uint8_t layer) {
+  switch(g) {
+    case G_Land:
+    case G_Vob:
+      return true;
+    case G_Obj:
+    case G_Itm:
+      return layer==0;
+    case G_Dec:
+    case G_Sky:
+    case G_Pfx:
+    case G_Count:
+      break;
     }
+  return false;
   }
 
-bool WorldView::needToUpdateCmd(uint8_t frameId) const {
-  return land    .needToUpdateCommands(frameId) ||
-         vobGroup.needToUpdateCommands(frameId) ||
-         objGroup.needToUpdateCommands(frameId) ||
-         itmGroup.needToUpdateCommands(frameId) ||
-         decGroup.needToUpdateCommands(frameId) ||
-         pfxGroup.needToUpdateCommands(frameId) ||
-         sky     .needToUpdateCommands(frameId);
+bool WorldView::needToUpdateCmd(Group g, uint8_t frameId) const {
+  switch(g) {
+    case G_Land:  return land    .needToUpdateCommands(frameId);
+    case G_Vob:   return vobGroup.needToUpdateCommands(frameId);
+    case G_Obj:   return objGroup.needToUpdateCommands(frameId);
+    case G_Itm:   return itmGroup.needToUpdateCommands(frameId);
+    case G_Dec:   return decGroup.needToUpdateCommands(frameId);
+    case G_Sky:   return sky     .needToUpdateCommands(frameId);
+    case G_Pfx:   return pfxGroup.needToUpdateCommands(frameId);
+    case G_Count: break;
+    }
+  return false;
   }
 
 void WorldView::invalidateCmd() {
   uint32_t count = storage.device.maxFramesInFlight();
   for(uint32_t i=0;i<count;++i) {
-    frame[i].actual=false;
+    for(auto& a:frame[i].actual)
+      a = false;
     }
   }
 
@@ -172,6 +221,7 @@ void WorldView::updateUbo(uint8_t frameId, const Matrix4x4& view, const Tempest:
   updateLight();
 
   auto viewProj=this->viewProj(view);
+
   sky .setMatrix(frameId,viewProj);
   sky .setLight (sun.dir());
 
@@ -199,9 +249,7 @@ void WorldView::updateUbo(uint8_t frameId, const Matrix4x4& view, const Tempest:
 void WorldView::builtCmdBuf(uint8_t frameId, const World &world,
                             const Attachment& main, const Attachment& shadowMap,
                             const FrameBufferLayout& mainLay,const FrameBufferLayout& shadowLay) {
-  auto&      device    = storage.device;
   auto&      pf        = frame[frameId];
-  const bool nToUpdate = needToUpdateCmd(frameId);
   auto&      smTexture = textureCast(shadowMap);
 
   sky     .commitUbo(frameId);
@@ -213,39 +261,16 @@ void WorldView::builtCmdBuf(uint8_t frameId, const World &world,
   decGroup.commitUbo(frameId,smTexture);
   pfxGroup.commitUbo(frameId,smTexture);
 
-  if(!pf.actual || nToUpdate) {
-    pf.actual=true;
-
-    // cascade#0 detail shadow
-    {
-    auto cmd    = pf.cmdShadow[0]   .startEncoding(device,shadowLay,smTexture.w(),smTexture.h());
-    auto cmdDyn = pf.cmdShadowDyn[0].startEncoding(device,shadowLay,smTexture.w(),smTexture.h());
-    land    .drawShadow(cmd,   frameId,0);
-    vobGroup.drawShadow(cmdDyn,frameId);
-    objGroup.drawShadow(cmd,   frameId);
-    itmGroup.drawShadow(cmd,   frameId);
-    }
-
-    // cascade#1 shadow
-    {
-    auto cmd = pf.cmdShadow[1].startEncoding(device,shadowLay,smTexture.w(),smTexture.h());
-    land.drawShadow(cmd,frameId,1);
-    vobGroup.drawShadow(cmd,frameId,1);
-    }
-
-    // main draw
-    {
-    auto cmd    = pf.cmdMain   .startEncoding(device,mainLay,main.w(),main.h());
-    auto cmdDyn = pf.cmdMainDyn.startEncoding(device,mainLay,main.w(),main.h());
-    land    .draw(cmd,   frameId);
-    vobGroup.draw(cmd,   frameId);
-    objGroup.draw(cmdDyn,frameId);
-    itmGroup.draw(cmd,   frameId);
-    decGroup.drawDecals(cmd,frameId);
-
-    sky     .draw(cmd,frameId,world);
-    pfxGroup.draw(cmd,frameId);
-    }
+  // only groups with changed content are re-recorded
+  for(uint8_t i=0;i<G_Count;++i) {
+    const Group g = Group(i);
+    if(pf.actual[i] && !needToUpdateCmd(g,frameId)) {
+      stats.reused++;
+      continue;
+      }
+    pf.actual[i] = true;
+    stats.recorded++;
+    recordGroup(g,frameId,world,main,smTexture,mainLay,shadowLay);
     }
 
   sky     .setAsUpdated(frameId);
@@ -256,3 +281,35 @@ void WorldView::builtCmdBuf(uint8_t frameId, const World &world,
   decGroup.setAsUpdated(frameId);
   pfxGroup.setAsUpdated(frameId);
   }
+
+void WorldView::recordGroup(Group g, uint8_t frameId, const World& world,
+                            const Attachment& main, const Texture2d& smTexture,
+                            const FrameBufferLayout& mainLay, const FrameBufferLayout& shadowLay) {
+  auto& device = storage.device;
+  auto& pf     = frame[frameId];
+
+  for(uint8_t layer=0;layer<2;++layer) {
+    if(!hasShadow(g,layer))
+      continue;
+    auto cmd = pf.cmdShadow[layer][g].startEncoding(device,shadowLay,smTexture.w(),smTexture.h());
+    switch(g) {
+      case G_Land: land    .drawShadow(cmd,frameId,layer); break;
+      case G_Vob:  vobGroup.drawShadow(cmd,frameId,layer); break;
+      case G_Obj:  objGroup.drawShadow(cmd,frameId);       break;
+      case G_Itm:  itmGroup.drawShadow(cmd,frameId);       break;
+      default: break;
+      }
+    }
+
+  auto cmd = pf.cmdMain[g].startEncoding(device,mainLay,main.w(),main.h());
+  switch(g) {
+    case G_Land:  land    .draw(cmd,frameId);       break;
+    case G_Vob:   vobGroup.draw(cmd,frameId);       break;
+    case G_Obj:   objGroup.draw(cmd,frameId);       break;
+    case G_Itm:   itmGroup.draw(cmd,frameId);       break;
+    case G_Dec:   decGroup.drawDecals(cmd,frameId); break;
+    case G_Sky:   sky     .draw(cmd,frameId,world); break;
+    case G_Pfx:   pfxGroup.draw(cmd,frameId);       break;
+    case G_Count: break;
+    }
+  }
@@ -11,6 +11,7 @@
 #include "graphics/meshobjects.h"
 #include "graphics/pfxobjects.h"
 #include "light.h"
+#include "lightgroup.h"
 
 class World;
 class RendererStorage;
@@ -44,12 +45,23 @@ class WorldView {
     MeshObjects::Mesh   getDecalView (const char* visual, float x, float y, float z, ProtoMesh& out);
     PfxObjects::Emitter getView      (const ParticleFx* decl);
 
+    struct RecordStats final {
+      uint64_t recorded=0; // secondary command buffers re-recorded
+      uint64_t reused  =0; // secondary command buffers executed as-is
+      };
+    const RecordStats&  recordStats() const { return stats; }
+
+    void                addLight     (const ZenLoad::zCVobData& vob);
+    void                setShadowView(const Tempest::Matrix4x4* shadow, size_t shCount);
+    const LightGroup&   lights       () const { return pointLights; }
+
   private:
     const World&            owner;
     const RendererStorage&  storage;
 
     Light                   sun;
     Tempest::Vec3           ambient;
+    LightGroup              pointLights;
 
     Sky                     sky;
     Landscape               land;
@@ -66,16 +78,30 @@ class WorldView {
     uint32_t                vpWidth=0;
     uint32_t                vpHeight=0;
 
+    // separately recorded parts of the scene; execution order is in mainOrder/shadowOrder
+    enum Group : uint8_t {
+      G_Land,
+      G_Vob,
+      G_Obj,
+      G_Itm,
+      G_Dec,
+      G_Sky,
+      G_Pfx,
+      G_Count
+      };
+    static const Group mainOrder  [G_Count];
+    static const Group shadowOrder[2][4];
+
     struct PerFrame {
-      Tempest::CommandBuffer cmdMain;
-      Tempest::CommandBuffer cmdMainDyn;
-      Tempest::CommandBuffer cmdShadow[2];
-      Tempest::CommandBuffer cmdShadowDyn[2];
-      bool                   actual     =true;
+      Tempest::CommandBuffer cmdMain  [G_Count];
+      Tempest::CommandBuffer cmdShadow[2][G_Count];
+      bool                   actual   [G_Count]={};
       };
     std::unique_ptr<PerFrame[]> frame;
+    RecordStats                 stats;
 
-    bool needToUpdateCmd(uint8_t frameId) const;
+    static bool hasShadow(Group g, uint8_t layer);
+    bool needToUpdateCmd(Group g, uint8_t frameId) const;
     void invalidateCmd();
 
     void updateLight();
@@ -85,4 +111,9 @@ class WorldView {
                      const Tempest::Attachment& shadowMap,
                      const Tempest::FrameBufferLayout &mainLay,
                      const Tempest::FrameBufferLayout &shadowLay);
+    void recordGroup(Group g, uint8_t frameId, const World &world,
+                     const Tempest::Attachment& main,
+                     const Tempest::Texture2d&  shadowMap,
+                     const Tempest::FrameBufferLayout &mainLay,
+                     const Tempest::FrameBufferLayout &shadowLay);
   };
@@ -4,8 +4,12 @@
 #include <Tempest/Application>
 
 #include <vector>
+#include <cstring>
 
 #include "utils/crashlog.h"
+#include "utils/tracer.h"
+#include "benchmark.h"
+#include "musicrender.h"
 #include "gothic.h"
 #include "mainwindow.h"
 
@@ -32,6 +36,8 @@ const char* selectDevice(const Tempest::VulkanApi& api) {
 
 int main(int argc,const char** argv) {
   CrashLog::setup();
+  if(argc>1 && std::strcmp(argv[1],"-render-music")==0)
+    return MusicRender::run(argc-2,argv+2);
   VDFS::FileIndex::initVDFS(argv[0]);
 
   Gothic               gothic{argc,argv};
@@ -39,8 +45,21 @@ int main(int argc,const char** argv) {
 
   Tempest::Device      device{api,selectDevice(api)};
   Resources            resources{gothic,device};
+  if(gothic.doCook())
+    return Resources::cookAssets() ? 0 : 1;
+  if(gothic.benchmarkTicks()>0) {
+    const int ret = Benchmark::run(gothic,device,gothic.benchmarkTicks());
+#if defined(OPENGOTHIC_TRACE)
+    Tracer::write("opengothic.trace.json");
+#endif
+    return ret;
+    }
 
   MainWindow           wx(gothic,device);
   Tempest::Application app;
-  return app.exec();
+  const int ret = app.exec();
+#if defined(OPENGOTHIC_TRACE)
+  Tracer::write("opengothic.trace.json");
+#endif
+  return ret;
   }
@@ -17,7 +17,9 @@
 #include "gothic.h"
 #include "game/serialize.h"
 #include "utils/crashlog.h"
+#include "utils/framebudget.h"
 #include "utils/gthfont.h"
+#include "utils/tracer.h"
 
 using namespace Tempest;
 
@@ -185,6 +187,31 @@ void MainWindow::paintEvent(PaintEvent& event) {
 
   auto& fnt = Resources::font();
   fnt.drawText(p,5,30,fpsT);
+
+  if(gothic.isDebugMode()) {
+    int y = 30+fnt.pixelSize();
+    for(auto& i:Resources::cacheStats()) {
+      char buf[128]={};
+      std::snprintf(buf,sizeof(buf),"%s: %u items, %u kb, hit %u, miss %u, failed %u",
+                    i.name,uint32_t(i.count),uint32_t(i.bytes/1024),uint32_t(i.hits),uint32_t(i.misses),uint32_t(i.failed));
+      fnt.drawText(p,5,y,buf);
+      y += fnt.pixelSize();
+      }
+    if(auto wview = gothic.worldView()) {
+      auto& st = wview->recordStats();
+      char  buf[128]={};
+      std::snprintf(buf,sizeof(buf),"cmd: %u re-recorded, %u reused",
+                    uint32_t(st.recorded),uint32_t(st.reused));
+      fnt.drawText(p,5,y,buf);
+      y += fnt.pixelSize();
+      }
+    auto& budget = FrameBudget::inst();
+    char  buf[128]={};
+    std::snprintf(buf,sizeof(buf),"budget: far animation %u, particles %u",
+                  uint32_t(budget.quality(FrameBudget::T_FarAnimation)),uint32_t(budget.quality(FrameBudget::T_Particles)));
+    fnt.drawText(p,5,y,buf);
+    y += fnt.pixelSize();
+    }
   }
 
 void MainWindow::resizeEvent(SizeEvent&) {
@@ -458,6 +485,7 @@ void MainWindow::drawSaving(Painter& p, int sw, int sh, float scale) {
   }
 
 void MainWindow::tick() {
+  TRACE_ZONE("MainWindow::tick");
   static bool once=true;
   if(once) {
     gothic.emitGlobalSoundWav("GAMESTART.WAV");
@@ -486,10 +514,49 @@ void MainWindow::tick() {
   if(gothic.isPause())
     return;
 
-  if(dt>50)
-    dt=50;
+  if(dt>MaxFrameTime)
+    dt=MaxFrameTime;
   dialogs.tick(dt);
   inventory.tick(dt);
+
+  FrameBudget::Scope scope;
+  simTime += dt;
+  for(uint32_t i=0; simTime>=Gothic::TickStep; ++i) {
+    if(i==MaxSteps) {
+      // simulation can't keep up: slow down the game instead of spending even more time on steps
+      simTime = simTime%Gothic::TickStep;
+      break;
+      }
+    simTime -= Gothic::TickStep;
+    beginStep();
+    tickStep(Gothic::TickStep);
+    if(gothic.checkLoading()!=Gothic::LoadState::Idle)
+      return;
+    }
+  interpolate(float(simTime)/float(Gothic::TickStep));
+  }
+
+void MainWindow::beginStep() {
+  if(auto c = gothic.gameCamera())
+    c->beginStep();
+  if(auto pl = gothic.player())
+    plPrev = pl->position();
+  }
+
+void MainWindow::interpolate(float k) {
+  // frame is displayed between two last simulation steps: blend camera and player to avoid judder
+  if(auto c = gothic.gameCamera())
+    c->setInterpolation(k);
+  if(auto pl = gothic.player()) {
+    auto cur = pl->position();
+    auto d   = plPrev-cur;
+    if(d.manhattanLength()>Camera::MaxLerpDistance)
+      d = Vec3(); // teleport
+    pl->setRenderShift(d*(1.f-k));
+    }
+  }
+
+void MainWindow::tickStep(uint64_t dt) {
   gothic.tick(dt);
 
   if(dialogs.isActive()){
@@ -611,6 +678,9 @@ void MainWindow::onWorldLoaded() {
   if(auto pl = gothic.player())
     pl->multSpeed(1.f);
   lastTick     = Application::tickCount();
+  simTime      = 0;
+  if(auto pl = gothic.player())
+    plPrev = pl->position();
   currentFocus = Focus();
   }
 
@@ -643,8 +713,10 @@ void MainWindow::render(){
     if(auto camera = gothic.gameCamera())
       renderer.setCameraView(*camera);
 
-    if(!gothic.isPause())
+    if(!gothic.isPause()) {
+      FrameBudget::Scope scope;
       gothic.updateAnimation();
+      }
 
     auto& context = fLocal[swapchain.frameId()];
 
@@ -660,8 +732,12 @@ void MainWindow::render(){
     const uint32_t imgId = swapchain.nextImage(context.imageAvailable);
 
     PrimaryCommandBuffer& cmd = commandDynamic[swapchain.frameId()];
+    {
+    FrameBudget::Scope scope;
     renderer.draw(cmd.startEncoding(device),swapchain.frameId(),uint8_t(imgId),uiLayer,numOverlay,inventory,gothic);
+    }
     device.submit(cmd,context.imageAvailable,context.renderDone,context.gpuLock);
+    FrameBudget::inst().commitFrame();
     device.present(swapchain,imgId,context.renderDone);
 
     auto t = Application::tickCount();
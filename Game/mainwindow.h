@@ -36,9 +36,9 @@
 #include "ui/documentmenu.h"
 #include "utils/keycodec.h"
 #include "resources.h"
+#include "gothic.h"
 
 class MenuRoot;
-class Gothic;
 class GameSession;
 class Interactive;
 
@@ -82,8 +82,16 @@ class MainWindow : public Tempest::Window {
     void render() override;
 
     void tick();
+    void tickStep(uint64_t dt);
+    void beginStep();
+    void interpolate(float k);
     Camera::Mode solveCameraMode() const;
 
+    // simulation advances in fixed Gothic::TickStep steps; frame may catch up few steps at most
+    // long frames are clamped to MaxFrameTime, so step cap must cover whole clamped frame
+    static constexpr uint64_t MaxFrameTime = 50;
+    static constexpr uint32_t MaxSteps     = uint32_t(MaxFrameTime/Gothic::TickStep);
+
     Tempest::Device&      device;
     Tempest::Swapchain    swapchain;
     Tempest::TextureAtlas atlas;
@@ -133,6 +141,8 @@ class MainWindow : public Tempest::Window {
     PlayerControl                       player;
     Focus                               currentFocus;
     uint64_t                            lastTick=0;
+    uint64_t                            simTime=0;
+    Tempest::Vec3                       plPrev;
 
     struct Fps {
       uint64_t dt[10]={};
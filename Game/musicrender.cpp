@@ -0,0 +1,207 @@
+#include "musicrender.h"
+
+#include <Tempest/File>
+#include <Tempest/Log>
+#include <Tempest/TextCodec>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "dmusic/directmusic.h"
+#include "dmusic/mixer.h"
+#include "dmusic/music.h"
+#include "dmusic/soundfont.h"
+
+using namespace Tempest;
+
+namespace {
+
+struct WavHeader final {
+  char     riff[4]      = {'R','I','F','F'};
+  uint32_t riffSize     = 0;
+  char     wave[4]      = {'W','A','V','E'};
+  char     fmt[4]       = {'f','m','t',' '};
+  uint32_t fmtSize      = 16;
+  uint16_t format       = 1;
+  uint16_t channels     = 2;
+  uint32_t sampleRate   = Dx8::SoundFont::SampleRate;
+  uint32_t byteRate     = uint32_t(Dx8::SoundFont::SampleRate*2*sizeof(int16_t));
+  uint16_t blockAlign   = uint16_t(2*sizeof(int16_t));
+  uint16_t bitsPerSample= 16;
+  char     data[4]      = {'d','a','t','a'};
+  uint32_t dataSize     = 0;
+  };
+
+void writeWav(const std::string& path, const std::vector<int16_t>& pcm) {
+  WavHeader hdr;
+  hdr.dataSize = uint32_t(pcm.size()*sizeof(int16_t));
+  hdr.riffSize = uint32_t(sizeof(hdr)-8+hdr.dataSize);
+
+  WFile f(path);
+  f.write(&hdr,sizeof(hdr));
+  f.write(pcm.data(),pcm.size()*sizeof(int16_t));
+  }
+
+// only 16bit stereo pcm, as written by writeWav
+bool readWav(const std::string& path, std::vector<int16_t>& pcm) {
+  RFile f(path);
+  std::vector<uint8_t> raw(size_t(f.size()));
+  f.read(raw.data(),raw.size());
+
+  if(raw.size()<12 || std::memcmp(&raw[0],"RIFF",4)!=0 || std::memcmp(&raw[8],"WAVE",4)!=0)
+    return false;
+
+  size_t at = 12;
+  bool   fmtOk = false;
+  while(at+8<=raw.size()) {
+    uint32_t sz = 0;
+    std::memcpy(&sz,&raw[at+4],4);
+    const uint8_t* chunk = &raw[at+8];
+    if(at+8+sz>raw.size())
+      return false;
+    if(std::memcmp(&raw[at],"fmt ",4)==0 && sz>=16) {
+      uint16_t format=0, channels=0, bits=0;
+      std::memcpy(&format,  chunk+0, 2);
+      std::memcpy(&channels,chunk+2, 2);
+      std::memcpy(&bits,    chunk+14,2);
+      fmtOk = (format==1 && channels==2 && bits==16);
+      }
+    if(std::memcmp(&raw[at],"data",4)==0) {
+      if(!fmtOk)
+        return false;
+      pcm.resize(sz/sizeof(int16_t));
+      std::memcpy(pcm.data(),chunk,pcm.size()*sizeof(int16_t));
+      return true;
+      }
+    at += 8+sz+(sz&1);
+    }
+  return false;
+  }
+
+// empty or different length signals never match
+double rmsDiff(const std::vector<int16_t>& a, const std::vector<int16_t>& b) {
+  const size_t n = a.size();
+  if(n==0 || n!=b.size())
+    return std::numeric_limits<double>::infinity();
+  double sum = 0;
+  for(size_t i=0;i<n;++i) {
+    double d = (double(a[i])-double(b[i]))/32768.0;
+    sum += d*d;
+    }
+  return std::sqrt(sum/double(n));
+  }
+
+void usage() {
+  Log::i("usage: -render-music <file.sgt> <out.wav> [-sec <seconds>] [-ref <reference.wav>] [-rms <threshold>]");
+  }
+
+}
+
+int MusicRender::run(int argc, const char** argv) {
+  std::string sgt, out, ref;
+  double      seconds   = 60;
+  double      threshold = 0.001;
+
+  for(int i=0;i<argc;++i) {
+    if(std::strcmp(argv[i],"-sec")==0 && i+1<argc)
+      seconds = std::atof(argv[++i]);
+    else if(std::strcmp(argv[i],"-ref")==0 && i+1<argc)
+      ref = argv[++i];
+    else if(std::strcmp(argv[i],"-rms")==0 && i+1<argc)
+      threshold = std::atof(argv[++i]);
+    else if(sgt.empty())
+      sgt = argv[i];
+    else if(out.empty())
+      out = argv[i];
+    }
+  if(sgt.empty() || out.empty() || seconds<=0) {
+    usage();
+    return 1;
+    }
+
+  // style and dls references are resolved relative to directory of segment
+  const size_t sep  = sgt.find_last_of("/\\");
+  std::string  dir  = sep==std::string::npos ? std::string() : sgt.substr(0,sep+1);
+  std::string  name = sep==std::string::npos ? sgt : sgt.substr(sep+1);
+
+  Dx8::DirectMusic dm;
+  dm.addPath(TextCodec::toUtf16(dir.c_str()));
+
+  Dx8::Music music;
+  try {
+    auto u = TextCodec::toUtf16(name.c_str());
+    Dx8::PatternList p = dm.load(u.c_str());
+    music.addPattern(p);
+    }
+  catch(std::runtime_error& e) {
+    Log::e("unable to load music: \"",sgt,"\" ",e.what());
+    return 1;
+    }
+  catch(std::system_error&) {
+    Log::e("unable to open music: \"",sgt,"\"");
+    return 1;
+    }
+
+  const size_t frames = size_t(seconds*Dx8::SoundFont::SampleRate);
+  const size_t block  = 1024;
+  std::vector<int16_t> pcm(frames*2);
+
+  Dx8::Mixer mix;
+  mix.setMusic(music);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for(size_t i=0;i<frames;i+=block) {
+    size_t n = std::min(block,frames-i);
+    mix.mix(&pcm[i*2],n);
+    }
+  auto   t1   = std::chrono::steady_clock::now();
+  double time = std::chrono::duration<double>(t1-t0).count();
+
+  char buf[256]={};
+  std::snprintf(buf,sizeof(buf),"%.2f sec of audio in %.3f sec, real-time factor %.1fx",
+                seconds,time,time>0 ? seconds/time : 0.0);
+  Log::i("render-music: ",buf);
+
+  try {
+    writeWav(out,pcm);
+    }
+  catch(std::system_error&) {
+    Log::e("unable to write: \"",out,"\"");
+    return 1;
+    }
+
+  if(ref.empty())
+    return 0;
+
+  std::vector<int16_t> refPcm;
+  try {
+    if(!readWav(ref,refPcm)) {
+      Log::e("unsupported reference wav: \"",ref,"\"");
+      return 1;
+      }
+    }
+  catch(std::system_error&) {
+    Log::e("unable to open reference: \"",ref,"\"");
+    return 1;
+    }
+
+  if(refPcm.size()!=pcm.size()) {
+    Log::e("render-music: reference length differs: ",uint32_t(refPcm.size())," samples, rendered ",uint32_t(pcm.size()));
+    return 2;
+    }
+
+  const double rms = rmsDiff(pcm,refPcm);
+  std::snprintf(buf,sizeof(buf),"rms difference %.6f (threshold %.6f)",rms,threshold);
+  if(rms>threshold) {
+    Log::e("render-music: ",buf);
+    return 2;
+    }
+  Log::i("render-music: ",buf);
+  return 0;
+  }
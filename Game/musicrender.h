@@ -0,0 +1,8 @@
+#pragma once
+
+// Offline rendering of DirectMusic segment into wav file, without audio device.
+// Used to measure mixer throughput and to compare mixer output against reference recording.
+class MusicRender final {
+  public:
+    static int run(int argc, const char** argv);
+  };
@@ -39,6 +39,7 @@
 
 #include "world/bullet.h"
 #include "graphics/submesh/packedmesh.h"
+#include "utils/tracer.h"
 
 const float DynamicWorld::ghostPadding=50-22.5f;
 const float DynamicWorld::ghostHeight =140;
@@ -909,6 +910,7 @@ void DynamicWorld::moveBullet(BulletBody &b, float dx, float dy, float dz, uint6
   }
 
 void DynamicWorld::tick(uint64_t dt) {
+  TRACE_ZONE("DynamicWorld::tick");
   npcList->updateAabbs();
   bulletList->tick(dt);
   }
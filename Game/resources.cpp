@@ -4,6 +4,7 @@
 #include <Tempest/Pixmap>
 #include <Tempest/Device>
 #include <Tempest/Dir>
+#include <Tempest/File>
 #include <Tempest/Application>
 #include <Tempest/Sound>
 #include <Tempest/SoundEffect>
@@ -18,6 +19,10 @@
 #include <zenload/ztex2dds.h>
 
 #include <fstream>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
 
 #include "graphics/submesh/staticmesh.h"
 #include "graphics/submesh/animmesh.h"
@@ -30,7 +35,10 @@
 #include "dmusic/music.h"
 #include "dmusic/directmusic.h"
 #include "utils/fileext.h"
+#include "utils/fileutil.h"
+#include "utils/mappedfile.h"
 #include "utils/gthfont.h"
+#include "utils/workers.h"
 
 #include "gothic.h"
 
@@ -38,6 +46,42 @@ using namespace Tempest;
 
 Resources* Resources::inst=nullptr;
 
+static thread_local bool worldScope = false;
+
+static size_t textureSize(const Texture2d& t) {
+  return size_t(t.w())*size_t(t.h())*4;
+  }
+
+static size_t meshSize(const ProtoMesh& m) {
+  size_t sz = 0;
+  for(auto& i:m.attach) {
+    sz += i.vbo.size()*sizeof(Resources::Vertex);
+    for(auto& s:i.sub)
+      sz += s.ibo.size()*sizeof(uint32_t);
+    }
+  for(auto& i:m.skined) {
+    sz += i.vbo.size()*sizeof(Resources::VertexA);
+    for(auto& s:i.sub)
+      sz += s.ibo.size()*sizeof(uint32_t);
+    }
+  return sz;
+  }
+
+static size_t skeletonSize(const Skeleton& s) {
+  size_t sz = s.nodes.size()*sizeof(Skeleton::Node) + s.tr.size()*sizeof(Tempest::Matrix4x4) + s.rootNodes.size()*sizeof(size_t);
+  for(auto& i:s.nodes)
+    sz += i.name.capacity();
+  return sz;
+  }
+
+static size_t animationSize(const Animation& a) {
+  return a.memoryUsage();
+  }
+
+static size_t soundSize(const Resources::SoundEntry& s) {
+  return s.bytes;
+  }
+
 static void emplaceTag(char* buf, char tag){
   for(size_t i=1;buf[i];++i){
     if(buf[i]==tag && buf[i-1]=='_' && buf[i+1]=='0'){
@@ -50,7 +94,10 @@ static void emplaceTag(char* buf, char tag){
   }
 
 Resources::Resources(Gothic &gothic, Tempest::Device &device)
-  : device(device), gothic(gothic) {
+  : device(device), gothic(gothic),
+    texCache("texture",textureSize), decalCache("decal",textureSize),
+    aniMeshCache("mesh",meshSize), skeletonCache("skeleton",skeletonSize),
+    animCache("animation",animationSize), sndCache("sound",soundSize) {
   inst=this;
 
   static std::array<VertexFsq,6> fsqBuf =
@@ -71,9 +118,6 @@ Resources::Resources(Gothic &gothic, Tempest::Device &device)
   dxMusic->addPath(gothic.nestedPath({u"_work",u"Data",u"Music",u"menu_men"}, Dir::FT_Dir));
   dxMusic->addPath(gothic.nestedPath({u"_work",u"Data",u"Music",u"orchestra"},Dir::FT_Dir));
 
-  fBuff .reserve(8*1024*1024);
-  ddsBuf.reserve(8*1024*1024);
-
   {
   Pixmap pm(1,1,Pixmap::Format::RGBA);
   uint8_t* pix = reinterpret_cast<uint8_t*>(pm.data());
@@ -90,17 +134,34 @@ Resources::Resources(Gothic &gothic, Tempest::Device &device)
   std::vector<Archive> archives;
   detectVdf(archives,gothic.nestedPath({u"Data"},Dir::FT_Dir));
 
-  // addon archives first!
+  // addon archives first! VDFS order: *.mod before *.vdf, then newest timestamp
   std::stable_sort(archives.begin(),archives.end(),[](const Archive& a,const Archive& b){
     int aIsMod = a.isMod ? 1 : -1;
     int bIsMod = b.isMod ? 1 : -1;
-    return std::make_tuple(aIsMod,a.time,int(a.ord)) >=
+    return std::make_tuple(aIsMod,a.time,int(a.ord)) >
            std::make_tuple(bIsMod,b.time,int(b.ord));
     });
 
-  for(auto& i:archives)
+  bool mapValid = true;
+  for(auto& i:archives) {
     gothicAssets.loadVDF(i.name);
+    if(i.map==nullptr) {
+      // content of this archive is unknown, so mapped entries of older archives may not shadow it
+      if(i.time>=0 && mapValid) {
+        Log::e("unable to map \"",TextCodec::toUtf8(i.name),"\", older archives are read through VDFS");
+        mapValid = false;
+        }
+      continue;
+      }
+    if(!mapValid)
+      continue;
+    // first archive wins, same as in gothicAssets
+    for(auto& e:i.map->entries())
+      archiveIndex.emplace(e.name,e.view);
+    archiveMap.emplace_back(std::move(i.map));
+    }
   gothicAssets.finalizeLoad();
+  setupCookDir(archives);
 
   //for(auto& i:gothicAssets.getKnownFiles())
   //  Log::i(i);
@@ -124,7 +185,13 @@ void Resources::detectVdf(std::vector<Archive>& ret, const std::u16string &root)
       auto file = root + vdf;
       Archive ar;
       ar.name  = root+vdf;
-      ar.time  = vdfTimestamp(ar.name);
+      try {
+        ar.map.reset(new VdfArchive(ar.name));
+        ar.time = ar.map->timestamp();
+        }
+      catch(...) {
+        ar.time = vdfTimestamp(ar.name);
+        }
       ar.ord   = uint16_t(ret.size());
       ar.isMod = vdf.rfind(u".mod")==vdf.size()-4;
 
@@ -141,6 +208,155 @@ void Resources::detectVdf(std::vector<Archive>& ret, const std::u16string &root)
     });
   }
 
+void Resources::setupCookDir(const std::vector<Archive>& archives) {
+  // cooked data is valid only for exact same set of archives
+  uint64_t hash = 0xcbf29ce484222325ull ^ COOK_VERSION;
+  auto     mix  = [&hash](uint64_t v){
+    hash ^= v;
+    hash *= 0x100000001b3ull;
+    };
+  for(auto& i:archives) {
+    mix(uint64_t(i.time));
+    for(auto c:i.name)
+      mix(c);
+    }
+
+  char buf[32]={};
+  std::snprintf(buf,sizeof(buf),"%016llx",static_cast<unsigned long long>(hash));
+  cookDir   = u"cache/" + TextCodec::toUtf16(buf) + u"/";
+  // marker is written last, so interrupted cook is not used
+  hasCooked = FileUtil::exists(cookDir+u"COOKED");
+  }
+
+std::u16string Resources::cookPath(const std::string& name) const {
+  std::string n = name;
+  for(auto& c:n)
+    c = char(std::toupper(c));
+  return cookDir + TextCodec::toUtf16(n) + u".DDS";
+  }
+
+bool Resources::cookAssets() {
+  return inst->implCook();
+  }
+
+bool Resources::implCook() {
+  if(!FileUtil::mkdir(u"cache") || !FileUtil::mkdir(cookDir)) {
+    Log::e("unable to create cache directory: \"",TextCodec::toUtf8(cookDir),"\"");
+    return false;
+    }
+  hasCooked = false;
+  if(!FileUtil::remove(cookDir+u"COOKED")) {
+    Log::e("unable to reset cache directory: \"",TextCodec::toUtf8(cookDir),"\"");
+    return false;
+    }
+
+  std::vector<std::string> tex;
+  for(auto& i:gothicAssets.getKnownFiles())
+    if(i.size()>6 && i.compare(i.size()-6,6,"-C.TEX")==0)
+      tex.push_back(i);
+
+  std::atomic<uint32_t> failed{0};
+  auto time = Application::tickCount();
+  Workers::parallelFor(tex,[this,&failed](std::string& ztex){
+    std::vector<uint8_t> data, dds;
+    std::string          name = ztex.substr(0,ztex.size()-6)+".TGA";
+    try {
+      if(!getFileData(ztex.c_str(),data))
+        throw std::runtime_error("no data");
+      ZenLoad::convertZTEX2DDS(data,dds);
+      WFile fout(cookPath(name));
+      fout.write(dds.data(),dds.size());
+      }
+    catch(...) {
+      Log::e("unable to cook texture \"",ztex,"\"");
+      // no partial files: loader takes any existing file as cooked
+      FileUtil::remove(cookPath(name));
+      failed.fetch_add(1);
+      }
+    });
+  time = Application::tickCount()-time;
+  Log::i("cook: ",uint32_t(tex.size())," textures in ",uint32_t(time),"ms");
+
+  try {
+    char buf[64]={};
+    std::snprintf(buf,sizeof(buf),"%u %u\n",unsigned(tex.size()),unsigned(failed.load()));
+    WFile fout(cookDir+u"COOKED");
+    fout.write(buf,std::strlen(buf));
+    }
+  catch(...) {
+    Log::e("unable to finalize cache directory: \"",TextCodec::toUtf8(cookDir),"\"");
+    return false;
+    }
+  hasCooked = true;
+  return failed.load()==0;
+  }
+
+Resources::WorldScope::WorldScope()
+  :prev(worldScope) {
+  worldScope = true;
+  }
+
+Resources::WorldScope::~WorldScope() {
+  worldScope = prev;
+  }
+
+uint64_t Resources::scopeEpoch() const {
+  return worldScope ? worldEpoch.load() : 0;
+  }
+
+void Resources::beginWorld() {
+  inst->worldEpoch.fetch_add(1);
+  }
+
+void Resources::trimCache() {
+  int budgetMb = inst->gothic.settingsGetI("INTERNAL","assetCacheBudget");
+  if(budgetMb<=0)
+    budgetMb = 1024;
+  const size_t   budget = size_t(budgetMb)*1024*1024;
+  const uint64_t epoch  = inst->worldEpoch.load();
+
+  auto remain = [budget](size_t other) {
+    return other<budget ? budget-other : 0;
+    };
+  // skeletons, animations and sounds are pinned, but still take part of the budget
+  const size_t pinned   = inst->skeletonCache.stats().bytes + inst->animCache.stats().bytes + inst->sndCache.stats().bytes;
+  const size_t texBytes = pinned + inst->texCache.stats().bytes + inst->decalCache.stats().bytes;
+
+  size_t freed = inst->aniMeshCache.evict(remain(texBytes),epoch,[](ProtoMesh& m){
+    std::lock_guard<std::mutex> g(inst->sync);
+    for(auto i=inst->bindCache.begin();i!=inst->bindCache.end();) {
+      if(std::get<1>(i->first)==&m)
+        i = inst->bindCache.erase(i); else
+        ++i;
+      }
+    });
+  // mesh, that was hit in this world, keeps epoch of it's textures from previous one: don't free them under it
+  std::unordered_set<const Texture2d*> used;
+  inst->aniMeshCache.forEach([&used](const ProtoMesh& m){
+    m.textures(used);
+    });
+  auto keep = [&used](const Texture2d& t){
+    return used.find(&t)!=used.end();
+    };
+
+  const size_t meshBytes = inst->aniMeshCache.stats().bytes;
+  freed += inst->texCache  .evict(remain(pinned+meshBytes+inst->decalCache.stats().bytes),epoch,[](Texture2d&){},keep);
+  freed += inst->decalCache.evict(remain(pinned+meshBytes+inst->texCache  .stats().bytes),epoch,[](Texture2d&){},keep);
+  if(freed>0)
+    Log::i("asset cache: evicted ",uint32_t(freed/1024),"kb");
+  }
+
+std::vector<AssetCacheStats> Resources::cacheStats() {
+  return {
+    inst->texCache.stats(),
+    inst->decalCache.stats(),
+    inst->aniMeshCache.stats(),
+    inst->skeletonCache.stats(),
+    inst->animCache.stats(),
+    inst->sndCache.stats(),
+    };
+  }
+
 const GthFont& Resources::dialogFont() {
   return font("font_old_10_white.tga",FontType::Normal);
   }
@@ -154,7 +370,7 @@ const GthFont &Resources::font(Resources::FontType type) {
   }
 
 const GthFont &Resources::font(const char* fname, FontType type) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  std::lock_guard<std::mutex> g(inst->sync);
   return inst->implLoadFont(fname,type);
   }
 
@@ -166,10 +382,6 @@ const Texture2d &Resources::fallbackBlack() {
   return inst->fbZero;
   }
 
-VDFS::FileIndex& Resources::vdfsIndex() {
-  return inst->gothicAssets;
-  }
-
 const Tempest::VertexBuffer<Resources::VertexFsq> &Resources::fsqVbo() {
   return inst->fsq;
   }
@@ -186,6 +398,8 @@ int64_t Resources::vdfTimestamp(const std::u16string& name) {
     RFile fin(name);
     fin.seek(VDF_COMMENT_LENGTH);
     fin.read(sign,VDF_SIGNATURE_LENGTH);
+    if(!VdfArchive::isSignature(sign,VDF_SIGNATURE_LENGTH))
+      return -1;
     fin.read(&count,sizeof(count));
     fin.seek(4);
     fin.read(&timestamp,sizeof(timestamp));
@@ -197,71 +411,70 @@ int64_t Resources::vdfTimestamp(const std::u16string& name) {
     }
   }
 
-Tempest::Texture2d* Resources::implLoadTexture(TextureCache& cache,const char* cname) {
-  std::string name = cname;
+std::unique_ptr<Texture2d> Resources::implLoadTexture(std::string name) {
+  // scratch buffers are per-thread, so textures can be decoded in parallel
+  static thread_local std::vector<uint8_t> fBuff, ddsBuf;
+
   if(name.size()==0)
     return nullptr;
 
-  auto it=cache.find(name);
-  if(it!=cache.end())
-    return it->second.get();
-
   if(FileExt::hasExt(name,"TGA")){
-    name.resize(name.size()+2);
-    std::memcpy(&name[0]+name.size()-6,"-C.TEX",6);
-    if(hasFile(name)) {
-      if(!getFileData(name.c_str(),fBuff)) {
-        Log::e("unable to load texture \"",name,"\"");
+    auto cooked = hasCooked ? cookPath(name) : std::u16string();
+    if(!cooked.empty() && FileUtil::exists(cooked)) {
+      // cooked file may be removed or truncated after check: fall back to game data then
+      try {
+        MappedFile dds(cooked);
+        if(auto t = implLoadTexture(dds.data(),dds.size()))
+          return t;
+        }
+      catch(...) {
+        Log::e("unable to read cooked texture of \"",name,"\"");
+        }
+      }
+
+    std::string tex = name;
+    tex.resize(tex.size()+2);
+    std::memcpy(&tex[0]+tex.size()-6,"-C.TEX",6);
+    if(hasFile(tex)) {
+      // NOTE: convertZTEX2DDS accepts only std::vector
+      if(!getFileData(tex.c_str(),fBuff)) {
+        Log::e("unable to load texture \"",tex,"\"");
         return nullptr;
         }
       ddsBuf.clear();
       ZenLoad::convertZTEX2DDS(fBuff,ddsBuf);
-      auto t = implLoadTexture(cache,cname,ddsBuf);
-      if(t!=nullptr) {
+      if(auto t = implLoadTexture(ddsBuf.data(),ddsBuf.size()))
         return t;
-        }
       }
     }
 
-  if(getFileData(cname,fBuff))
-    return implLoadTexture(cache,cname,fBuff);
-
-  cache[name]=nullptr;
+  auto view = getFileView(name);
+  if(view.data!=nullptr)
+    return implLoadTexture(view.data,view.size);
+  if(getFileData(name.c_str(),fBuff))
+    return implLoadTexture(fBuff.data(),fBuff.size());
   return nullptr;
   }
 
-Texture2d *Resources::implLoadTexture(TextureCache& cache,std::string&& name,const std::vector<uint8_t> &data) {
+std::unique_ptr<Texture2d> Resources::implLoadTexture(const uint8_t* data, size_t size) {
   try {
-    Tempest::MemReader rd(data.data(),data.size());
+    Tempest::MemReader rd(data,size);
     Tempest::Pixmap    pm(rd);
 
-    std::unique_ptr<Texture2d> t{new Texture2d(device.loadTexture(pm))};
-    Texture2d* ret=t.get();
-    cache[std::move(name)] = std::move(t);
-    return ret;
+    std::lock_guard<std::mutex> g(devSync);
+    return std::unique_ptr<Texture2d>{new Texture2d(device.loadTexture(pm))};
     }
   catch(...){
     return nullptr;
     }
   }
 
-ProtoMesh* Resources::implLoadMesh(const std::string &name) {
+std::unique_ptr<ProtoMesh> Resources::implLoadMesh(const std::string &name) {
   if(name.size()==0)
     return nullptr;
 
-  if(name=="DOOR_NW_RICH_01.MDS")
-    Log::d("");
-
-  auto it=aniMeshCache.find(name);
-  if(it!=aniMeshCache.end())
-    return it->second.get();
-
   if(FileExt::hasExt(name,"TGA")){
-    static std::unordered_set<std::string> dec;
-    if(dec.find(name)==dec.end()) {
-      Log::e("decals are not implemented yet \"",name,"\"");
-      dec.insert(name);
-      }
+    Log::e("decals are not implemented yet \"",name,"\"");
     return nullptr;
     }
 
@@ -269,12 +482,10 @@ ProtoMesh* Resources::implLoadMesh(const std::string &name) {
     ZenLoad::PackedMesh        sPacked;
     ZenLoad::zCModelMeshLib    library;
     auto                       code=loadMesh(sPacked,library,name);
-    std::unique_ptr<ProtoMesh> t{code==MeshLoadCode::Static ? new ProtoMesh(std::move(sPacked),name) : new ProtoMesh(library,name)};
-    ProtoMesh* ret=t.get();
-    aniMeshCache[name] = std::move(t);
     if(code==MeshLoadCode::Error)
       throw std::runtime_error("load failed");
-    return ret;
+    std::unique_ptr<ProtoMesh> t{code==MeshLoadCode::Static ? new ProtoMesh(std::move(sPacked),name) : new ProtoMesh(library,name)};
+    return t;
     }
   catch(...){
     Log::e("unable to load mesh \"",name,"\"");
@@ -282,25 +493,14 @@ ProtoMesh* Resources::implLoadMesh(const std::string &name) {
     }
   }
 
-Skeleton* Resources::implLoadSkeleton(std::string name) {
-  if(name.size()==0)
-    return nullptr;
-
-  FileExt::exchangeExt(name,"MDS","MDH") ||
-  FileExt::exchangeExt(name,"ASC","MDL");
-
-  auto it=skeletonCache.find(name);
-  if(it!=skeletonCache.end())
-    return it->second.get();
-
+std::unique_ptr<Skeleton> Resources::implLoadSkeleton(const std::string& name) {
   try {
-    ZenLoad::zCModelMeshLib library(name,gothicAssets,1.f);
-    std::unique_ptr<Skeleton> t{new Skeleton(library,name)};
-    Skeleton* ret=t.get();
-    skeletonCache[name] = std::move(t);
     if(!hasFile(name))
       throw std::runtime_error("load failed");
-    return ret;
+    std::unique_lock<std::recursive_mutex> g(vdfSync);
+    ZenLoad::zCModelMeshLib library(name,gothicAssets,1.f);
+    g.unlock();
+    return std::unique_ptr<Skeleton>{new Skeleton(library,name)};
     }
   catch(...){
     Log::e("unable to load skeleton \"",name,"\"");
@@ -308,37 +508,29 @@ Skeleton* Resources::implLoadSkeleton(std::string name) {
     }
   }
 
-Animation* Resources::implLoadAnimation(std::string name) {
-  if(name.size()<4)
-    return nullptr;
-
-  auto it=animCache.find(name);
-  if(it!=animCache.end())
-    return it->second.get();
-
+std::unique_ptr<Animation> Resources::implLoadAnimation(std::string name) {
   try {
-    Animation* ret=nullptr;
+    std::unique_ptr<Animation> ret;
     if(gothic.version().game==2){
       FileExt::exchangeExt(name,"MDS","MSB") ||
       FileExt::exchangeExt(name,"MDH","MSB");
 
-      if(name=="Orc.MSB")
-        Log::d("");
-
-      ZenLoad::ZenParser            zen(name,gothicAssets);
+      auto                          data = getFileData(name);
+      if(data.empty())
+        throw std::runtime_error("load failed");
+      ZenLoad::ZenParser            zen(data.data(),data.size());
       ZenLoad::MdsParserBin         p(zen);
 
-      std::unique_ptr<Animation> t{new Animation(p,name.substr(0,name.size()-4),false)};
-      ret=t.get();
-      animCache[name] = std::move(t);
+      ret.reset(new Animation(p,name.substr(0,name.size()-4),false));
       } else {
       FileExt::exchangeExt(name,"MDH","MDS");
-      ZenLoad::ZenParser zen(name,gothicAssets);
+      auto                  data = getFileData(name);
+      if(data.empty())
+        throw std::runtime_error("load failed");
+      ZenLoad::ZenParser    zen(data.data(),data.size());
       ZenLoad::MdsParserTxt p(zen);
 
-      std::unique_ptr<Animation> t{new Animation(p,name.substr(0,name.size()-4),true)};
-      ret=t.get();
-      animCache[name] = std::move(t);
+      ret.reset(new Animation(p,name.substr(0,name.size()-4),true));
       }
     if(!hasFile(name))
       throw std::runtime_error("load failed");
@@ -350,25 +542,23 @@ Animation* Resources::implLoadAnimation(std::string name) {
     }
   }
 
-SoundEffect *Resources::implLoadSound(const char* name) {
-  if(name==nullptr || *name=='\0')
-    return nullptr;
+std::unique_ptr<Resources::SoundEntry> Resources::implLoadSound(const char* name) {
+  static thread_local std::vector<uint8_t> fBuff;
 
-  auto it=sndCache.find(name);
-  if(it!=sndCache.end())
-    return it->second.get();
-
-  if(!getFileData(name,fBuff))
-    return nullptr;
+  auto view = getFileView(name);
+  if(view.data==nullptr) {
+    if(!getFileData(name,fBuff))
+      return nullptr;
+    view.data = fBuff.data();
+    view.size = fBuff.size();
+    }
 
   try {
-    Tempest::MemReader rd(fBuff.data(),fBuff.size());
+    Tempest::MemReader rd(view.data,view.size);
 
+    std::lock_guard<std::mutex> g(devSync);
     auto s = sound.load(rd);
-    std::unique_ptr<SoundEffect> t{new SoundEffect(std::move(s))};
-    SoundEffect* ret=t.get();
-    sndCache[name] = std::move(t);
-    return ret;
+    return std::unique_ptr<SoundEntry>{new SoundEntry{std::move(s),view.size}};
     }
   catch(...){
     Log::e("unable to load sound \"",name,"\"");
@@ -382,13 +572,20 @@ Dx8::PatternList Resources::implLoadDxMusic(const char* name) {
   }
 
 Sound Resources::implLoadSoundBuffer(const char *name) {
+  static thread_local std::vector<uint8_t> fBuff;
+
   if(name[0]=='\0')
     return Sound();
 
-  if(!getFileData(name,fBuff))
-    return Sound();
+  auto view = getFileView(name);
+  if(view.data==nullptr) {
+    if(!getFileData(name,fBuff))
+      return Sound();
+    view.data = fBuff.data();
+    view.size = fBuff.size();
+    }
   try {
-    Tempest::MemReader rd(fBuff.data(),fBuff.size());
+    Tempest::MemReader rd(view.data,view.size);
     return Sound(rd);
     }
   catch(...){
@@ -443,36 +640,42 @@ GthFont &Resources::implLoadFont(const char* fname, FontType type) {
       break;
     }
 
-  auto ptr   = std::make_unique<GthFont>(fnt,tex,color,gothicAssets);
+  std::lock_guard<std::recursive_mutex> g(vdfSync);
+  auto ptr   = std::make_unique<GthFont>(fnt,loadTexture(tex),color,gothicAssets);
   GthFont* f = ptr.get();
   gothicFnt[std::make_pair(fname,type)] = std::move(ptr);
   return *f;
   }
 
 bool Resources::hasFile(const std::string &fname) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  std::lock_guard<std::recursive_mutex> g(inst->vdfSync);
   return inst->gothicAssets.hasFile(fname);
   }
 
 const Texture2d* Resources::loadDecal(const char* name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  if(auto t = inst->implLoadTexture(inst->decalCache,name)){
-    Tempest::Sampler2d smp;
-    smp.setClamping(Tempest::ClampMode::ClampToEdge);
-    t->setSampler(smp);
+  if(name==nullptr || *name=='\0')
+    return nullptr;
+  return inst->decalCache.get(name,inst->scopeEpoch(),[name]() {
+    auto t = inst->implLoadTexture(name);
+    if(t!=nullptr) {
+      Tempest::Sampler2d smp;
+      smp.setClamping(Tempest::ClampMode::ClampToEdge);
+      t->setSampler(smp);
+      }
     return t;
-    }
-  return nullptr;
+    });
   }
 
 const Texture2d *Resources::loadTexture(const char *name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadTexture(inst->texCache,name);
+  if(name==nullptr || *name=='\0')
+    return nullptr;
+  return inst->texCache.get(name,inst->scopeEpoch(),[name]() {
+    return inst->implLoadTexture(name);
+    });
   }
 
 const Tempest::Texture2d* Resources::loadTexture(const std::string &name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadTexture(inst->texCache,name.c_str());
+  return loadTexture(name.c_str());
   }
 
 const Texture2d *Resources::loadTexture(const std::string &name, int32_t iv, int32_t ic) {
@@ -498,7 +701,7 @@ const Texture2d *Resources::loadTexture(const std::string &name, int32_t iv, int
   }
 
 Texture2d Resources::loadTexture(const Pixmap &pm) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  std::lock_guard<std::mutex> g(inst->devSync);
   return inst->device.loadTexture(pm);
   }
 
@@ -508,59 +711,108 @@ Material Resources::loadMaterial(const ZenLoad::zCMaterialData& src) {
   }
 
 const ProtoMesh *Resources::loadMesh(const std::string &name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadMesh(name);
+  return inst->aniMeshCache.get(name,inst->scopeEpoch(),[&name]() {
+    return inst->implLoadMesh(name);
+    });
   }
 
-const Skeleton *Resources::loadSkeleton(const char* name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadSkeleton(name);
+const Skeleton *Resources::loadSkeleton(const char* cname) {
+  std::string name = cname;
+  if(name.size()==0)
+    return nullptr;
+
+  FileExt::exchangeExt(name,"MDS","MDH") ||
+  FileExt::exchangeExt(name,"ASC","MDL");
+
+  return inst->skeletonCache.get(name,0,[&name]() {
+    return inst->implLoadSkeleton(name);
+    });
   }
 
 const Animation *Resources::loadAnimation(const std::string &name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadAnimation(name);
+  if(name.size()<4)
+    return nullptr;
+  return inst->animCache.get(name,0,[&name]() {
+    return inst->implLoadAnimation(name);
+    });
   }
 
 SoundEffect *Resources::loadSound(const char *name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadSound(name);
+  if(name==nullptr || *name=='\0')
+    return nullptr;
+  auto s = inst->sndCache.get(name,0,[name]() {
+    return inst->implLoadSound(name);
+    });
+  return s==nullptr ? nullptr : &s->fx;
   }
 
 SoundEffect *Resources::loadSound(const std::string &name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
-  return inst->implLoadSound(name.c_str());
+  return loadSound(name.c_str());
   }
 
 Sound Resources::loadSoundBuffer(const std::string &name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
   return inst->implLoadSoundBuffer(name.c_str());
   }
 
 Sound Resources::loadSoundBuffer(const char *name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
   return inst->implLoadSoundBuffer(name);
   }
 
 Dx8::PatternList Resources::loadDxMusic(const char* name) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  std::lock_guard<std::mutex> g(inst->sync);
   return inst->implLoadDxMusic(name);
   }
 
+Resources::FileView Resources::getFileView(const char* name) {
+  std::string n = name;
+  for(auto& c:n)
+    c = char(std::toupper(c));
+  auto it = inst->archiveIndex.find(n);
+  if(it==inst->archiveIndex.end())
+    return FileView();
+  inst->viewBytes.fetch_add(it->second.size);
+  inst->viewCount.fetch_add(1);
+  return it->second;
+  }
+
+Resources::FileView Resources::getFileView(const std::string& name) {
+  return getFileView(name.c_str());
+  }
+
+Resources::IoStats Resources::ioStats() {
+  IoStats st;
+  st.copyBytes = inst->copyBytes.load();
+  st.copyCount = inst->copyCount.load();
+  st.viewBytes = inst->viewBytes.load();
+  st.viewCount = inst->viewCount.load();
+  st.sysCalls  = MappedFile::syscalls() + inst->vdfsReads.load();
+  return st;
+  }
+
 bool Resources::getFileData(const char *name, std::vector<uint8_t> &dat) {
   dat.clear();
-  return inst->gothicAssets.getFileData(name,dat);
+  auto view = getFileView(name);
+  if(view.data!=nullptr)
+    dat.assign(view.data,view.data+view.size); else {
+    std::lock_guard<std::recursive_mutex> g(inst->vdfSync);
+    inst->vdfsReads.fetch_add(1);
+    if(!inst->gothicAssets.getFileData(name,dat))
+      return false;
+    }
+  inst->copyBytes.fetch_add(dat.size());
+  inst->copyCount.fetch_add(1);
+  return true;
   }
 
 std::vector<uint8_t> Resources::getFileData(const char *name) {
   std::vector<uint8_t> data;
-  inst->gothicAssets.getFileData(name,data);
+  getFileData(name,data);
   return data;
   }
 
 std::vector<uint8_t> Resources::getFileData(const std::string &name) {
   std::vector<uint8_t> data;
-  inst->gothicAssets.getFileData(name,data);
+  getFileData(name.c_str(),data);
   return data;
   }
 
@@ -580,7 +832,9 @@ Resources::MeshLoadCode Resources::loadMesh(ZenLoad::PackedMesh& sPacked, ZenLoa
     }
 
   if(FileExt::hasExt(name,"MRM")) {
+    std::unique_lock<std::recursive_mutex> g(vdfSync);
     ZenLoad::zCProgMeshProto zmsh(name,gothicAssets);
+    g.unlock();
     if(zmsh.getNumSubmeshes()==0)
       return MeshLoadCode::Error;
     zmsh.packMesh(sPacked,1.f);
@@ -588,7 +842,9 @@ Resources::MeshLoadCode Resources::loadMesh(ZenLoad::PackedMesh& sPacked, ZenLoa
     }
 
   if(FileExt::hasExt(name,"MMB")) {
+    std::unique_lock<std::recursive_mutex> g(vdfSync);
     ZenLoad::zCMorphMesh zmm(name,gothicAssets);
+    g.unlock();
     if(zmm.getMesh().getNumSubmeshes()==0)
       return MeshLoadCode::Error;
     zmm.getMesh().packMesh(sPacked,1.f);
@@ -612,6 +868,7 @@ Resources::MeshLoadCode Resources::loadMesh(ZenLoad::PackedMesh& sPacked, ZenLoa
   }
 
 ZenLoad::zCModelMeshLib Resources::loadMDS(std::string &name) {
+  std::lock_guard<std::recursive_mutex> g(vdfSync);
   if(FileExt::exchangeExt(name,"MDMS","MDM"))
     return ZenLoad::zCModelMeshLib(name,gothicAssets,1.f);
   if(hasFile(name))
@@ -639,7 +896,7 @@ ZenLoad::zCModelMeshLib Resources::loadMDS(std::string &name) {
   }
 
 const AttachBinder *Resources::bindMesh(const ProtoMesh &anim, const Skeleton &s, const char *defBone) {
-  std::lock_guard<std::recursive_mutex> g(inst->sync);
+  std::lock_guard<std::mutex> g(inst->sync);
 
   if(anim.submeshId.size()==0){
     static AttachBinder empty;
@@ -12,8 +12,12 @@
 #include <zenload/zTypes.h>
 
 #include <tuple>
+#include <mutex>
+#include <atomic>
 
 #include "world/soundfx.h"
+#include "utils/assetcache.h"
+#include "utils/vdfarchive.h"
 
 class Gothic;
 class StaticMesh;
@@ -96,23 +100,58 @@ class Resources final {
     static Dx8::PatternList          loadDxMusic(const char *name);
 
     template<class V>
-    static Tempest::VertexBuffer<V>  vbo(const V* data,size_t sz){ return inst->device.vbo(data,sz); }
+    static Tempest::VertexBuffer<V>  vbo(const V* data,size_t sz){
+      std::lock_guard<std::mutex> g(inst->devSync);
+      return inst->device.vbo(data,sz);
+      }
 
     template<class V>
-    static Tempest::IndexBuffer<V>   ibo(const V* data,size_t sz){ return inst->device.ibo(data,sz); }
+    static Tempest::IndexBuffer<V>   ibo(const V* data,size_t sz){
+      std::lock_guard<std::mutex> g(inst->devSync);
+      return inst->device.ibo(data,sz);
+      }
+
+    using FileView = VdfArchive::View;
+
+    struct IoStats final {
+      uint64_t copyBytes=0;
+      uint64_t copyCount=0;
+      uint64_t viewBytes=0;
+      uint64_t viewCount=0;
+      uint64_t sysCalls =0; // open/stat/map/unmap/close of mapped files, plus one per read through VDFS
+      };
+
+    static FileView                  getFileView(const char*        name);
+    static FileView                  getFileView(const std::string& name);
+    static IoStats                   ioStats();
 
     static std::vector<uint8_t>      getFileData(const char*        name);
     static bool                      getFileData(const char*        name,std::vector<uint8_t>& dat);
     static std::vector<uint8_t>      getFileData(const std::string& name);
 
     static bool                      hasFile(const std::string& fname);
-    static VDFS::FileIndex&          vdfsIndex();
+    static bool                      cookAssets();
+
+    // meshes and textures, loaded while WorldScope is alive, are owned by current world and can be evicted later
+    class WorldScope final {
+      public:
+        WorldScope();
+        ~WorldScope();
+      private:
+        bool prev=false;
+      };
+
+    static void                      beginWorld();
+    static void                      trimCache();
+    static std::vector<AssetCacheStats> cacheStats();
 
     static const Tempest::VertexBuffer<VertexFsq>& fsqVbo();
 
   private:
     static Resources* inst;
 
+    static const uint64_t COOK_VERSION = 1;
+
     enum class MeshLoadCode : uint8_t {
       Error,
       Static,
@@ -120,24 +159,34 @@ class Resources final {
       };
 
     struct Archive {
-      std::u16string name;
-      int64_t        time=0;
-      uint16_t       ord=0;
-      bool           isMod=false;
+      std::u16string              name;
+      int64_t                     time=0;
+      uint16_t                    ord=0;
+      bool                        isMod=false;
+      std::unique_ptr<VdfArchive> map;
       };
 
-    using TextureCache = std::unordered_map<std::string,std::unique_ptr<Tempest::Texture2d>>;
+    struct SoundEntry final {
+      Tempest::SoundEffect fx;
+      size_t               bytes=0; // size of source file; decoded effect has no size query
+      };
+
+    using TextureCache = AssetCache<std::string,Tempest::Texture2d>;
 
     int64_t               vdfTimestamp(const std::u16string& name);
     void                  detectVdf(std::vector<Archive>& ret, const std::u16string& root);
 
-    Tempest::Texture2d*   implLoadTexture(TextureCache& cache, const char* cname);
-    Tempest::Texture2d*   implLoadTexture(TextureCache& cache, std::string &&name, const std::vector<uint8_t> &data);
-    ProtoMesh*            implLoadMesh(const std::string &name);
-    Skeleton*             implLoadSkeleton(std::string name);
-    Animation*            implLoadAnimation(std::string name);
+    void                  setupCookDir(const std::vector<Archive>& archives);
+    std::u16string        cookPath(const std::string& name) const;
+    bool                  implCook();
+
+    auto                  implLoadTexture(std::string name) -> std::unique_ptr<Tempest::Texture2d>;
+    auto                  implLoadTexture(const uint8_t* data, size_t size) -> std::unique_ptr<Tempest::Texture2d>;
+    auto                  implLoadMesh(const std::string &name) -> std::unique_ptr<ProtoMesh>;
+    auto                  implLoadSkeleton(const std::string& name) -> std::unique_ptr<Skeleton>;
+    auto                  implLoadAnimation(std::string name) -> std::unique_ptr<Animation>;
     Tempest::Sound        implLoadSoundBuffer(const char* name);
-    Tempest::SoundEffect* implLoadSound(const char *name);
+    auto                  implLoadSound(const char *name) -> std::unique_ptr<SoundEntry>;
     Dx8::PatternList      implLoadDxMusic(const char *name);
     GthFont&              implLoadFont(const char* fname, FontType type);
 
@@ -145,6 +194,8 @@ class Resources final {
     ZenLoad::zCModelMeshLib loadMDS (std::string& name);
     Tempest::VertexBuffer<Vertex> sphere(int passCount, float R);
 
+    uint64_t              scopeEpoch() const;
+
     Tempest::Texture2d fallback, fbZero;
 
     using BindK = std::tuple<const Skeleton*,const ProtoMesh*,const std::string>;
@@ -162,23 +213,31 @@ class Resources final {
 
     Tempest::Device&      device;
     Tempest::SoundDevice  sound;
-    std::recursive_mutex  sync;
+    std::mutex            sync;
+    std::mutex            devSync;
+    // VDFS::FileIndex and ZenLib parsers on top of it are not thread-safe; assets are loaded from workers too
+    std::recursive_mutex  vdfSync;
     std::unique_ptr<Dx8::DirectMusic> dxMusic;
     Gothic&               gothic;
     VDFS::FileIndex       gothicAssets;
+    std::vector<std::unique_ptr<VdfArchive>>  archiveMap;
+    std::unordered_map<std::string,FileView>  archiveIndex;
+    std::atomic<uint64_t> copyBytes{0}, copyCount{0}, viewBytes{0}, viewCount{0}, vdfsReads{0};
+    std::atomic<uint64_t> worldEpoch{1};
+    std::u16string        cookDir;
+    bool                  hasCooked=false;
 
-    std::vector<uint8_t>  fBuff, ddsBuf;
     Tempest::VertexBuffer<VertexFsq>         fsq;
 
     TextureCache                                                          texCache;
     TextureCache                                                          decalCache;
 
-    std::unordered_map<std::string,std::unique_ptr<ProtoMesh>>            aniMeshCache;
-    std::unordered_map<std::string,std::unique_ptr<Skeleton>>             skeletonCache;
-    std::unordered_map<std::string,std::unique_ptr<Animation>>            animCache;
+    AssetCache<std::string,ProtoMesh>                                     aniMeshCache;
+    AssetCache<std::string,Skeleton>                                      skeletonCache;
+    AssetCache<std::string,Animation>                                     animCache;
     std::unordered_map<BindK,std::unique_ptr<AttachBinder>,Hash>          bindCache;
 
-    std::unordered_map<std::string,std::unique_ptr<Tempest::SoundEffect>> sndCache;
+    AssetCache<std::string,SoundEntry>                                    sndCache;
     std::unordered_map<FontK,std::unique_ptr<GthFont>,Hash>               gothicFnt;
   };
 
@@ -0,0 +1,123 @@
+#include "test.h"
+
+#include <future>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "utils/assetcache.h"
+
+// stand-ins for Texture2d and ProtoMesh: mesh keeps raw pointers to textures of another cache
+struct Tex final {
+  std::string name;
+  };
+
+struct Mesh final {
+  std::vector<const Tex*> tex;
+  };
+
+using TexCache  = AssetCache<std::string,Tex>;
+using MeshCache = AssetCache<std::string,Mesh>;
+
+static size_t texSize (const Tex&)  { return 1024; }
+static size_t meshSize(const Mesh&) { return 4096; }
+
+static const Tex* loadTex(TexCache& c, const std::string& name, uint64_t epoch) {
+  return c.get(name,epoch,[&name](){
+    return std::unique_ptr<Tex>(new Tex{name});
+    });
+  }
+
+static const Mesh* loadMesh(MeshCache& mc, TexCache& tc, const std::string& name, uint64_t epoch, int& loads) {
+  return mc.get(name,epoch,[&](){
+    ++loads;
+    std::unique_ptr<Mesh> m(new Mesh());
+    m->tex.push_back(loadTex(tc,name+"_BODY.TGA",epoch));
+    m->tex.push_back(loadTex(tc,name+"_HEAD.TGA",epoch));
+    return m;
+    });
+  }
+
+// same order as Resources::trimCache: meshes first, then textures not referenced by surviving meshes
+static void trim(MeshCache& mc, TexCache& tc, uint64_t epoch) {
+  mc.evict(0,epoch,[](Mesh&){});
+  std::unordered_set<const Tex*> used;
+  mc.forEach([&used](const Mesh& m){
+    used.insert(m.tex.begin(),m.tex.end());
+    });
+  tc.evict(0,epoch,[](Tex&){},[&used](const Tex& t){
+    return used.find(&t)!=used.end();
+    });
+  }
+
+// mesh loaded in world 1 and hit in world 2: its textures must survive trim of world 1 assets
+static void crossWorldHit() {
+  TexCache  tc("tex", texSize);
+  MeshCache mc("mesh",meshSize);
+  int       loads = 0;
+
+  auto m1 = loadMesh(mc,tc,"HUM_BODY",1,loads);
+  loadTex(tc,"WORLD1_ONLY.TGA",1);
+  CHECK(tc.stats().count==3);
+
+  // world 2
+  auto m2 = loadMesh(mc,tc,"HUM_BODY",2,loads);
+  CHECK(m1==m2);
+  CHECK(loads==1);
+
+  trim(mc,tc,2);
+  CHECK(mc.stats().count==1);
+  CHECK(tc.stats().count==2);
+  CHECK(tc.stats().bytes==2*1024);
+
+  // still same objects: mesh pointers are valid
+  CHECK(loadTex(tc,"HUM_BODY_BODY.TGA",2)==m2->tex[0]);
+  CHECK(loadTex(tc,"HUM_BODY_HEAD.TGA",2)==m2->tex[1]);
+  CHECK(m2->tex[0]->name=="HUM_BODY_BODY.TGA");
+
+  // world 3 without that mesh: both mesh and textures go away
+  trim(mc,tc,4);
+  CHECK(mc.stats().count==0);
+  CHECK(tc.stats().count==0);
+  CHECK(tc.stats().bytes==0);
+  }
+
+// pinned entries (loaded outside of world scope) are never evicted
+static void pinned() {
+  TexCache tc("tex",texSize);
+  loadTex(tc,"MENU.TGA",0);
+  loadTex(tc,"LEVEL.TGA",1);
+  tc.evict(0,5,[](Tex&){});
+  CHECK(tc.stats().count==1);
+  CHECK(loadTex(tc,"MENU.TGA",5)->name=="MENU.TGA");
+  }
+
+// loader requests own key (font -> texture -> same font): inner request fails instead of deadlock,
+// other keys still load from inside of loader and from other threads
+static void reentrantLoad() {
+  TexCache   tc("tex",texSize);
+  Tex        none;
+  const Tex* inner = &none;
+  const Tex* other = nullptr;
+  auto outer = tc.get("FONT.TGA",1,[&](){
+    inner = loadTex(tc,"FONT.TGA",1);
+    other = loadTex(tc,"OTHER.TGA",1);
+    return std::unique_ptr<Tex>(new Tex{"FONT.TGA"});
+    });
+  CHECK(inner==nullptr);
+  CHECK(other!=nullptr && other->name=="OTHER.TGA");
+  CHECK(outer!=nullptr && outer->name=="FONT.TGA");
+
+  // once loaded, same key is plain cache hit, also from other thread
+  CHECK(loadTex(tc,"FONT.TGA",1)==outer);
+  auto th = std::async(std::launch::async,[&](){ return loadTex(tc,"FONT.TGA",1); });
+  CHECK(th.get()==outer);
+  CHECK(tc.stats().count==2);
+  }
+
+int main() {
+  crossWorldHit();
+  pinned();
+  reentrantLoad();
+  return Test::result("assetcache");
+  }
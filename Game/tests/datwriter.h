@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <daedalus/DaedalusVM.h>
+#include <daedalus/DaedalusStdlib.h>
+
+// writes small compiled script (.dat) in memory: symbol table and byte-code of instance/function bodies;
+// tests use it instead of game data, to load real Daedalus::DaedalusVM over known content
+class DatWriter final {
+  public:
+    enum Type : uint32_t {
+      T_Void, T_Float, T_Int, T_String, T_Class, T_Func, T_Prototype, T_Instance
+      };
+
+    DatWriter() {
+      // global instance variables, assigned by vm on every call
+      for(auto n:{"SELF","OTHER","VICTIM","ITEM","HERO"})
+        add(n,T_Instance,0,0,size_t(-1));
+      }
+
+    size_t klass(const char* name) {
+      return add(name,T_Class,0,0,size_t(-1));
+      }
+
+    size_t member(size_t cls, const char* name, Type t, uint32_t count=1) {
+      std::string full = sym[cls].name+"."+name;
+      auto id = add(full.c_str(),t,count,F_ClassVar,cls);
+      sym[cls].count++;
+      return id;
+      }
+
+    size_t constInt(const char* name, std::vector<int32_t> v) {
+      auto id = add(name,T_Int,uint32_t(v.size()),F_Const,size_t(-1));
+      sym[id].i = std::move(v);
+      return id;
+      }
+
+    size_t constString(const char* name, std::vector<std::string> v) {
+      auto id = add(name,T_String,uint32_t(v.size()),F_Const,size_t(-1));
+      sym[id].s = std::move(v);
+      return id;
+      }
+
+    // body of instance follows, until end()
+    size_t instance(const char* name, size_t cls) {
+      auto id = add(name,T_Instance,0,F_Const,cls);
+      sym[id].addr = uint32_t(code.size());
+      return id;
+      }
+
+    // function without arguments, returns int; body follows, until end()
+    size_t func(const char* name) {
+      auto id = add(name,T_Func,0,F_Const|F_Return,size_t(-1));
+      sym[id].ret  = T_Int;
+      sym[id].addr = uint32_t(code.size());
+      return id;
+      }
+
+    // member = "text"
+    void setString(size_t mem, const char* text) {
+      auto lit = add((char(-1)+std::to_string(10000+literals++)).c_str(),T_String,1,F_Const,size_t(-1));
+      sym[lit].s = {text};
+      op(Op_PushVar,lit);
+      op(Op_PushVar,mem);
+      op(Op_AssignString);
+      }
+
+    // member[index] = value
+    void setInt(size_t mem, int32_t value, uint8_t index=0) {
+      op(Op_PushInt,uint32_t(value));
+      if(index==0) {
+        op(Op_PushVar,mem);
+        } else {
+        op(Op_PushArrayVar,mem);
+        code.push_back(index);
+        }
+      op(Op_Assign);
+      }
+
+    // return value
+    void ret(int32_t value) {
+      op(Op_PushInt,uint32_t(value));
+      op(Op_Ret);
+      }
+
+    void end() {
+      op(Op_Ret);
+      }
+
+    std::vector<uint8_t> build() const {
+      std::vector<uint8_t> out;
+      out.push_back(50); // version
+
+      std::vector<uint32_t> sort(sym.size());
+      for(uint32_t i=0;i<sort.size();++i)
+        sort[i] = i;
+      std::sort(sort.begin(),sort.end(),[this](uint32_t a,uint32_t b){ return sym[a].name<sym[b].name; });
+
+      u32(out,uint32_t(sym.size()));
+      for(auto i:sort)
+        u32(out,i);
+
+      for(auto& s:sym) {
+        u32(out,1);
+        str(out,s.name);
+
+        u32(out,s.type==T_Class ? s.count*4 : s.ret); // class size, or return type of function
+        u32(out,(s.type==T_Class ? s.count : s.length) | (uint32_t(s.type)<<12) | (s.flags<<16));
+        for(int i=0;i<5;++i)
+          u32(out,0); // source location
+
+        if((s.flags & F_ClassVar)==0) {
+          switch(s.type) {
+            case T_Float:
+              for(uint32_t i=0;i<s.length;++i)
+                u32(out,0);
+              break;
+            case T_Int:
+              for(auto v:s.i)
+                u32(out,uint32_t(v));
+              break;
+            case T_String:
+              for(auto& v:s.s)
+                str(out,v);
+              break;
+            case T_Class:
+            case T_Func:
+            case T_Prototype:
+            case T_Instance:
+              u32(out,s.addr);
+              break;
+            case T_Void:
+              break;
+            }
+          }
+        u32(out,s.parent==size_t(-1) ? uint32_t(-1) : uint32_t(s.parent));
+        }
+
+      u32(out,uint32_t(code.size()));
+      out.insert(out.end(),code.begin(),code.end());
+      return out;
+      }
+
+    std::unique_ptr<Daedalus::DaedalusVM> vm() const {
+      auto bytes = build();
+      auto ret   = std::make_unique<Daedalus::DaedalusVM>(bytes.data(),bytes.size());
+      Daedalus::registerGothicEngineClasses(*ret);
+      return ret;
+      }
+
+  private:
+    enum Flag : uint32_t {
+      F_Const=1, F_Return=2, F_ClassVar=4
+      };
+
+    enum Op : uint8_t {
+      Op_Assign=9, Op_Ret=60, Op_PushInt=64, Op_PushVar=65, Op_AssignString=70, Op_PushArrayVar=245
+      };
+
+    struct Sym final {
+      std::string              name;
+      Type                     type=T_Void;
+      uint32_t                 length=0;
+      uint32_t                 flags=0;
+      uint32_t                 count=0;  // class: number of members
+      uint32_t                 ret=0;
+      uint32_t                 addr=0;
+      size_t                   parent=size_t(-1);
+      std::vector<int32_t>     i;
+      std::vector<std::string> s;
+      };
+
+    size_t add(const char* name, Type t, uint32_t length, uint32_t flags, size_t parent) {
+      Sym s;
+      s.name   = name;
+      s.type   = t;
+      s.length = length;
+      s.flags  = flags;
+      s.parent = parent;
+      sym.push_back(std::move(s));
+      return sym.size()-1;
+      }
+
+    void op(Op o) {
+      code.push_back(o);
+      }
+
+    void op(Op o, size_t arg) {
+      code.push_back(o);
+      u32(code,uint32_t(arg));
+      }
+
+    static void u32(std::vector<uint8_t>& out, uint32_t v) {
+      for(int i=0;i<4;++i)
+        out.push_back(uint8_t(v>>(i*8)));
+      }
+
+    static void str(std::vector<uint8_t>& out, const std::string& s) {
+      out.insert(out.end(),s.begin(),s.end());
+      out.push_back('\n');
+      }
+
+    std::vector<Sym>     sym;
+    std::vector<uint8_t> code;
+    uint32_t             literals=0;
+  };
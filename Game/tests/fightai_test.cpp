@@ -0,0 +1,135 @@
+#include "test.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "datwriter.h"
+#include "game/definitions/fightaidefinitions.h"
+
+using C_FightAI = Daedalus::GEngineClasses::C_FightAI;
+using FA        = FightAi::FA;
+
+enum { MaxFightAi = 4, MaxMove = Daedalus::GEngineClasses::MAX_MOVE };
+
+static const struct {
+  const char*      name;
+  FightAi::Queue FA::* queue;
+  } queues[] = {
+  {"ENEMY_PREHIT",      &FA::enemy_prehit     },
+  {"ENEMY_STORMPREHIT", &FA::enemy_stormprehit},
+  {"MY_W_COMBO",        &FA::my_w_combo       },
+  {"MY_W_RUNTO",        &FA::my_w_runto       },
+  {"MY_W_STRAFE",       &FA::my_w_strafe      },
+  {"MY_W_FOCUS",        &FA::my_w_focus       },
+  {"MY_W_NOFOCUS",      &FA::my_w_nofocus     },
+  {"MY_G_COMBO",        &FA::my_g_combo       },
+  {"MY_G_RUNTO",        &FA::my_g_runto       },
+  {"MY_G_STRAFE",       &FA::my_g_strafe      },
+  {"MY_G_FOCUS",        &FA::my_g_focus       },
+  {"MY_FK_FOCUS",       &FA::my_fk_focus      },
+  {"MY_G_FK_NOFOCUS",   &FA::my_g_fk_nofocus  },
+  {"MY_FK_FOCUS_FAR",   &FA::my_fk_focus_far  },
+  {"MY_FK_NOFOCUS_FAR", &FA::my_fk_nofocus_far},
+  {"MY_FK_FOCUS_MAG",   &FA::my_fk_focus_mag  },
+  {"MY_FK_NOFOCUS_MAG", &FA::my_fk_nofocus_mag},
+  };
+
+static std::string symbol(const char* queue, size_t tactic) {
+  return std::string("FA_")+queue+"_"+std::to_string(tactic);
+  }
+
+// every tactic defines queues of all lengths from empty to full; some have MOVE_NULL in the middle,
+// some are not defined at all
+static std::unique_ptr<Daedalus::DaedalusVM> mkVm() {
+  DatWriter dat;
+  dat.constInt("MAX_FIGHTAI",{MaxFightAi});
+  auto cls  = dat.klass("C_FIGHTAI");
+  auto move = dat.member(cls,"MOVE",DatWriter::T_Int,MaxMove);
+
+  for(size_t t=1;t<MaxFightAi;++t)
+    for(size_t q=0;q<sizeof(queues)/sizeof(queues[0]);++q) {
+      if((t+q)%5==4)
+        continue;
+      dat.instance(symbol(queues[q].name,t).c_str(),cls);
+      const size_t len = (t*7+q)%(MaxMove+1);
+      for(size_t i=0;i<len;++i) {
+        const bool hole = (q%3==0 && i==2);
+        dat.setInt(move,hole ? 0 : int32_t(1+(t+q+i)%6),uint8_t(i));
+        }
+      dat.end();
+      }
+  return dat.vm();
+  }
+
+// move selection of FightAlgo before compiled queues: move[] is scanned up to first MOVE_NULL
+static bool pickReference(const C_FightAI& src, uint32_t rnd, int32_t& queueId) {
+  uint32_t sz=0;
+  for(size_t i=0;i<MaxMove;++i){
+    if(src.move[i]==0)
+      break;
+    sz++;
+    }
+  if(sz==0)
+    return false;
+  queueId = src.move[rnd%sz];
+  return queueId!=0;
+  }
+
+static bool pick(const FightAi::Queue& src, uint32_t rnd, int32_t& queueId) {
+  if(src.size==0)
+    return false;
+  queueId = src.move[rnd%src.size];
+  return queueId!=0;
+  }
+
+// same moves are drawn from compiled queue, as from scan over script instance, for any random value
+static void sameAsReference() {
+  auto    vm = mkVm();
+  FightAi fai(*vm);
+
+  auto&  dat     = vm->getDATFile();
+  size_t checked = 0, empty = 0;
+  for(size_t t=1;t<MaxFightAi;++t)
+    for(auto& q:queues) {
+      auto&     queue = fai.get(t).*q.queue;
+      C_FightAI src   = {};
+      auto      name  = symbol(q.name,t);
+      if(dat.hasSymbolName(name))
+        vm->initializeInstance(src,dat.getSymbolIndexByName(name),Daedalus::IC_FightAi);
+
+      CHECK(queue.size<=MaxMove);
+      for(size_t i=0;i<queue.size;++i)
+        CHECK(queue.move[i]!=0);
+      for(uint32_t rnd=0;rnd<64;++rnd) {
+        int32_t a=-1, b=-1;
+        CHECK(pickReference(src,rnd,a)==pick(queue,rnd,b));
+        CHECK(a==b);
+        }
+      ++checked;
+      if(queue.size==0)
+        ++empty;
+      }
+  vm->clearReferences(Daedalus::IC_FightAi);
+
+  CHECK(checked==(MaxFightAi-1)*sizeof(queues)/sizeof(queues[0]));
+  CHECK(empty>0 && empty<checked);
+  }
+
+// tactic 0 is not loaded, out of range gives empty tactic
+static void emptyTactics() {
+  auto    vm = mkVm();
+  FightAi fai(*vm);
+  for(auto& q:queues) {
+    CHECK((fai.get(0).*q.queue).size==0);
+    CHECK((fai.get(MaxFightAi).*q.queue).size==0);
+    CHECK((fai.get(size_t(-1)).*q.queue).size==0);
+    }
+  }
+
+int main() {
+  sameAsReference();
+  emptyTactics();
+  return Test::result("fightai");
+  }
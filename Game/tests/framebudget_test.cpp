@@ -0,0 +1,88 @@
+#include "test.h"
+
+#include "utils/framebudget.h"
+
+// feeds same fake timings for number of frames
+static void run(FrameBudget& b, int frames, uint64_t frameUs, uint64_t farUs, uint64_t particlesUs) {
+  const uint64_t task[FrameBudget::T_Count] = {farUs,particlesUs};
+  for(int i=0;i<frames;++i)
+    b.commitFrame(frameUs,task);
+  }
+
+// let averages settle without any reaction, then apply real budget
+static void settle(FrameBudget& b, uint64_t frameUs, uint64_t farUs, uint64_t particlesUs) {
+  b.setBudget(1000000);
+  run(b,100,frameUs,farUs,particlesUs);
+  b.setBudget(10000);
+  }
+
+// least important task is degraded first; next one only if saving of first does not cover overshoot
+static void degradeUntilCovered() {
+  {
+  FrameBudget b;
+  settle(b,10500,2000,2000);
+  run(b,1,10500,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+  CHECK(b.quality(FrameBudget::T_Particles)==0);
+  }
+  {
+  FrameBudget b;
+  settle(b,14000,2000,8000);
+  run(b,1,14000,2000,8000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+  CHECK(b.quality(FrameBudget::T_Particles)==1);
+  }
+  {
+  // within budget: nothing to do
+  FrameBudget b;
+  settle(b,9000,2000,2000);
+  run(b,20,9000,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==0);
+  CHECK(b.quality(FrameBudget::T_Particles)==0);
+  }
+  }
+
+// quality comes back only if doubled cost of reduced task fits under low watermark (85% of budget)
+static void restoreIfDoubledFits() {
+  FrameBudget b;
+  settle(b,10500,2000,2000);
+  run(b,1,10500,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+
+  // task now costs 1000us, but only ~500us are free under 8500us
+  run(b,100,8000,1000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+
+  // ~1500us free: doubled cost fits
+  run(b,100,7000,1000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==0);
+  }
+
+// after change of quality, policy waits for averages to settle
+static void cooldown() {
+  FrameBudget b;
+  settle(b,20000,2000,2000);
+  run(b,1,20000,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+  CHECK(b.quality(FrameBudget::T_Particles)==1);
+
+  run(b,8,20000,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==1);
+  CHECK(b.quality(FrameBudget::T_Particles)==1);
+
+  run(b,1,20000,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==2);
+  CHECK(b.quality(FrameBudget::T_Particles)==2);
+
+  // lowest level is kept
+  run(b,100,20000,2000,2000);
+  CHECK(b.quality(FrameBudget::T_FarAnimation)==2);
+  CHECK(b.quality(FrameBudget::T_Particles)==2);
+  }
+
+int main() {
+  degradeUntilCovered();
+  restoreIfDoubledFits();
+  cooldown();
+  return Test::result("framebudget");
+  }
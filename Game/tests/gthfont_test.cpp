@@ -0,0 +1,194 @@
+#include "test.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "utils/gthfont.h"
+
+using namespace Tempest;
+
+using Glyph = GthFont::Glyph;
+
+// synthetic 16x16 atlas: every byte has own cell and width; space is narrow, like in Gothic fonts
+static GthFont::FontInfo mkAtlas() {
+  GthFont::FontInfo info{};
+  info.fontHeight = 12;
+  for(int i=0;i<256;++i) {
+    info.glyphWidth[i] = uint8_t(i==' ' ? 3 : 4+i%7);
+    info.fontUV1[i].x  = float(i%16)/16.f;
+    info.fontUV1[i].y  = float(i/16)/16.f;
+    info.fontUV2[i].x  = float(i%16+1)/16.f;
+    info.fontUV2[i].y  = float(i/16+1)/16.f;
+    }
+  return info;
+  }
+
+// uncached drawText of the font, before glyph runs were introduced; quads are relative to text origin
+struct Reference final {
+  const GthFont::FontInfo& info;
+
+  Glyph glyph(uint8_t id, int x, int y) const {
+    Glyph g;
+    g.x  = x;
+    g.y  = y;
+    g.w  = info.glyphWidth[id];
+    g.u1 = info.fontUV1[id].x;
+    g.v1 = info.fontUV1[id].y;
+    g.u2 = info.fontUV2[id].x;
+    g.v2 = info.fontUV2[id].y;
+    return g;
+    }
+
+  int textWidth(const uint8_t* b, const uint8_t* e) const {
+    int x=0, w=0;
+    for(auto i=b;i!=e;) {
+      if(*i=='\n') {
+        w = std::max(w,x);
+        x = 0;
+        ++i;
+        while(i!=e && *i==' ')
+          ++i;
+        } else {
+        x += info.glyphWidth[*i];
+        ++i;
+        }
+      }
+    return std::max(w,x);
+    }
+
+  const uint8_t* word(const uint8_t* txt, int& width, int& space) const {
+    width = 0;
+    space = 0;
+    for(;*txt==' ';++txt)
+      space += info.glyphWidth[' '];
+    for(;*txt!='\0' && *txt!='\n' && *txt!=' ';++txt)
+      width += info.glyphWidth[*txt];
+    return txt;
+    }
+
+  const uint8_t* line(const uint8_t* txt, int bw) const {
+    int x=0, ww=0, ws=0;
+    txt = word(txt,ww,ws);
+    x  += ww+ws;
+    while(*txt!='\0' && *txt!='\n') {
+      auto t = word(txt,ww,ws);
+      x += ww+ws;
+      if(x>bw)
+        return txt;
+      txt = t;
+      }
+    return *txt=='\0' ? txt : txt+1;
+    }
+
+  std::vector<Glyph> wrap(const char* str, int bw, AlignFlag align) const {
+    std::vector<Glyph> ret;
+    auto      txt = reinterpret_cast<const uint8_t*>(str);
+    const int h   = int(info.fontHeight);
+    int       y   = -h;
+    while(*txt) {
+      auto t = line(txt,bw);
+      int  x = 0;
+      if(align & AlignHCenter)
+        x = (bw-textWidth(txt,t))/2;
+      if(align & AlignRight)
+        x = bw-textWidth(txt,t);
+      for(auto i=txt;i!=t;++i) {
+        ret.push_back(glyph(*i,x,y));
+        x += info.glyphWidth[*i];
+        }
+      while(*t==' ')
+        ++t;
+      txt = t;
+      y  += h;
+      }
+    return ret;
+    }
+
+  std::vector<Glyph> single(const char* str) const {
+    std::vector<Glyph> ret;
+    int x = 0;
+    for(auto txt=reinterpret_cast<const uint8_t*>(str);*txt;++txt) {
+      ret.push_back(glyph(*txt,x,-int(info.fontHeight)));
+      x += info.glyphWidth[*txt];
+      }
+    return ret;
+    }
+  };
+
+static bool same(const std::vector<Glyph>& a, const std::vector<Glyph>& b) {
+  if(a.size()!=b.size())
+    return false;
+  for(size_t i=0;i<a.size();++i) {
+    if(a[i].x!=b[i].x || a[i].y!=b[i].y || a[i].w!=b[i].w)
+      return false;
+    if(a[i].u1!=b[i].u1 || a[i].v1!=b[i].v1 || a[i].u2!=b[i].u2 || a[i].v2!=b[i].v2)
+      return false;
+    }
+  return true;
+  }
+
+static const char* const sample[] = {
+  "",
+  "hello world",
+  "multi\nline  text\n  indented",
+  "a rather long line of dialog text, that has to be wrapped into several lines of the box",
+  "   leading spaces",
+  "trailing spaces   ",
+  "\n\nempty lines\n",
+  "Supercalifragilisticexpialidocious",
+  };
+
+static const AlignFlag align[] = {NoAlign, AlignLeft, AlignHCenter, AlignRight};
+static const int       width[] = {0, 60, 150, 1000};
+
+// cache miss, cache hit and re-layout after eviction give same quads as uncached path
+static void quadEquivalence() {
+  const auto atlas = mkAtlas();
+  GthFont    fnt(atlas,nullptr,Color());
+  Reference  ref{atlas};
+
+  for(int pass=0;pass<3;++pass) {
+    for(auto s:sample) {
+      CHECK(same(fnt.glyphRun(s),ref.single(s)));
+      for(auto a:align)
+        for(auto w:width)
+          CHECK(same(fnt.glyphRun(s,w,a),ref.wrap(s,w,a)));
+
+      auto sz = fnt.textSize(s);
+      auto e  = reinterpret_cast<const uint8_t*>(s)+std::strlen(s);
+      CHECK(sz.w==ref.textWidth(reinterpret_cast<const uint8_t*>(s),e));
+      }
+
+    // flood layout cache, so next pass starts from evicted entries
+    if(pass==1) {
+      for(int i=0;i<3000;++i) {
+        auto s = std::to_string(i*7919);
+        fnt.glyphRun(s.c_str());
+        fnt.textSize(s);
+        }
+      }
+    }
+  }
+
+// key does not keep pointer to caller's text: same buffer with new content is laid out again
+static void reusedBuffer() {
+  const auto atlas = mkAtlas();
+  GthFont    fnt(atlas,nullptr,Color());
+  Reference  ref{atlas};
+
+  char buf[32] = "first text";
+  CHECK(same(fnt.glyphRun(buf,100,AlignLeft),ref.wrap(buf,100,AlignLeft)));
+  std::strcpy(buf,"other one");
+  CHECK(same(fnt.glyphRun(buf,100,AlignLeft),ref.wrap(buf,100,AlignLeft)));
+  CHECK(same(fnt.glyphRun(buf),ref.single(buf)));
+  std::strcpy(buf,"first text");
+  CHECK(same(fnt.glyphRun(buf),ref.single(buf)));
+  CHECK(fnt.textSize(buf).h==12);
+  }
+
+int main() {
+  quadEquivalence();
+  reusedBuffer();
+  return Test::result("gthfont");
+  }
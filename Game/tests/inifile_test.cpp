@@ -0,0 +1,85 @@
+#include "test.h"
+
+#include <fstream>
+#include <string>
+
+#include "utils/inifile.h"
+
+static std::string readAll(const char* file) {
+  std::ifstream fin(file,std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+  }
+
+static void writeSample(const char* file) {
+  std::ofstream fout(file,std::ios::binary);
+  fout << "; header, before any section\n"
+       << "orphan=1\n"
+       << "[GAME]\n"
+       << "; in-section comment\n"
+       << "invertCameraY=1\n"
+       << "playerName=Hero\n"
+       << "\n"
+       << "[SOUND]\r\n"
+       << "soundVolume=0.75\r\n"
+       << "musicEnabled=0\r\n";
+  }
+
+// values are parsed, lines before first section are ignored, like in original Gothic.ini reader
+static void parse() {
+  writeSample("inifile_test.ini");
+  IniFile ini(u"inifile_test.ini");
+
+  CHECK(ini.getI("GAME","invertCameraY")==1);
+  CHECK(ini.getS("GAME","playerName")=="Hero");
+  CHECK(ini.has ("SOUND","soundVolume"));
+  CHECK(ini.getS("SOUND","soundVolume")=="0.75");
+  CHECK(ini.getI("SOUND","musicEnabled")==0);
+
+  CHECK(!ini.has("","orphan"));
+  CHECK(!ini.has("GAME","orphan"));
+  CHECK(!ini.has("GAME","missing"));
+  CHECK(!ini.has("MISSING","invertCameraY"));
+  CHECK(ini.getI("MISSING","invertCameraY")==0);
+  CHECK(ini.getS("MISSING","invertCameraY").empty());
+  }
+
+// set+flush+reload keeps values and in-section comments; unchanged file is stable
+static void roundTrip() {
+  writeSample("inifile_test.ini");
+  {
+  IniFile ini(u"inifile_test.ini");
+  ini.set("GAME", "invertCameraY",0);
+  ini.set("VIDEO","zVidResFullscreenX",1920);
+  ini.flush();
+  }
+
+  const std::string first = readAll("inifile_test.ini");
+  CHECK(first.find("; in-section comment")!=std::string::npos);
+  CHECK(first.find("; header")==std::string::npos);
+  CHECK(first.find("orphan")==std::string::npos);
+
+  {
+  IniFile ini(u"inifile_test.ini");
+  CHECK(ini.getI("GAME", "invertCameraY")==0);
+  CHECK(ini.getS("GAME", "playerName")=="Hero");
+  CHECK(ini.getI("VIDEO","zVidResFullscreenX")==1920);
+  CHECK(ini.getI("SOUND","musicEnabled")==0);
+
+  // same value again: file must be rewritten byte-identical
+  ini.set("GAME","invertCameraY",0);
+  ini.flush();
+  }
+  CHECK(readAll("inifile_test.ini")==first);
+
+  // comment is kept once, not duplicated by rewrite
+  size_t n=0;
+  for(size_t at=first.find("; in-section");at!=std::string::npos;at=first.find("; in-section",at+1))
+    ++n;
+  CHECK(n==1);
+  }
+
+int main() {
+  parse();
+  roundTrip();
+  return Test::result("inifile");
+  }
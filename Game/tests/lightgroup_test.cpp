@@ -0,0 +1,46 @@
+#include "test.h"
+
+#include "graphics/lightgroup.h"
+
+static ZenLoad::zCVobData mkVob(float x, float y, float z, uint32_t argb, float range) {
+  ZenLoad::zCVobData vob;
+  vob.position.x       = x;
+  vob.position.y       = y;
+  vob.position.z       = z;
+  vob.zCVobLight.color = argb;
+  vob.zCVobLight.range = range;
+  return vob;
+  }
+
+// zCVobLight is converted into position, normalized rgb color and range
+static void ingest() {
+  LightGroup g;
+  g.add(mkVob(1,2,3,0xFF804020,500));
+
+  CHECK(g.size()==1);
+  auto& l = g.lights()[0];
+  CHECK(l.pos.x==1 && l.pos.y==2 && l.pos.z==3);
+  CHECK(l.color.x==float(0x80)/255.f);
+  CHECK(l.color.y==float(0x40)/255.f);
+  CHECK(l.color.z==float(0x20)/255.f);
+  CHECK(l.range==500);
+  }
+
+// lights without range can't affect anything and are not stored
+static void zeroRange() {
+  LightGroup g;
+  g.add(mkVob(0,0,0,0xFFFFFFFF,0));
+  g.add(mkVob(0,0,0,0xFFFFFFFF,-1));
+  CHECK(g.size()==0);
+
+  LightGroup::Source s;
+  s.range = 10;
+  g.add(s);
+  CHECK(g.size()==1);
+  }
+
+int main() {
+  ingest();
+  zeroRange();
+  return Test::result("lightgroup");
+  }
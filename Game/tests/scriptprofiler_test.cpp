@@ -0,0 +1,151 @@
+#include "test.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "game/scriptprofiler.h"
+
+// stub of compiled script: symbol table of functions, each does some work and calls other symbols,
+// same way as runFunction and external trampolines of GameScript enter profiler
+struct StubDat final {
+  struct Func final {
+    const char*         name;
+    uint32_t            workUs;
+    std::vector<size_t> calls;
+    };
+  std::vector<Func> sym;
+
+  void run(ScriptProfiler& prof, size_t id) const {
+    ScriptProfiler::Scope scope(&prof,id,sym[id].name);
+    spin(sym[id].workUs);
+    for(auto c:sym[id].calls)
+      run(prof,c);
+    }
+
+  static void spin(uint32_t us) {
+    auto end = std::chrono::steady_clock::now()+std::chrono::microseconds(us);
+    while(std::chrono::steady_clock::now()<end)
+      ;
+    }
+  };
+
+enum Sym : size_t { S_Startup, S_AiState, S_Condition, S_Recursive, S_External };
+
+// startup -> 3x ai-state -> condition + external; recursive function calls itself 3 levels deep
+static StubDat scenario() {
+  StubDat d;
+  d.sym = {
+    {"STARTUP_WORLD",   50, {S_AiState,S_AiState,S_AiState,S_Recursive}},
+    {"ZS_TALK",         20, {S_Condition,S_External}},
+    {"DIA_CONDITION",   10, {}},
+    {"B_RECURSIVE",     10, {}},
+    {"NPC_ISDEAD",       5, {}},
+    };
+  return d;
+  }
+
+static void runScenario(const StubDat& dat, ScriptProfiler& prof) {
+  dat.run(prof,S_Startup);
+  // recursion through same symbol
+  prof.enter(S_Recursive,"B_RECURSIVE");
+  prof.enter(S_Recursive,"B_RECURSIVE");
+  dat.run(prof,S_Recursive);
+  prof.leave();
+  prof.leave();
+  }
+
+// counts, and exclusive times of all frames add up to inclusive time of root frames
+static void callStats() {
+  auto           dat = scenario();
+  ScriptProfiler prof("");
+  runScenario(dat,prof);
+
+  CHECK(prof.stats(S_Startup)->calls==1);
+  CHECK(prof.stats(S_AiState)->calls==3);
+  CHECK(prof.stats(S_Condition)->calls==3);
+  CHECK(prof.stats(S_External)->calls==3);
+  CHECK(prof.stats(S_Recursive)->calls==4);
+  CHECK(prof.stats(S_AiState)->name=="ZS_TALK");
+  CHECK(prof.stats(100)==nullptr);
+
+  uint64_t excl = 0;
+  for(size_t i=0;i<dat.sym.size();++i) {
+    auto s = prof.stats(i);
+    CHECK(s->excl<=s->incl);
+    CHECK(s->active==0);
+    // two of recursive frames are entered directly, without work
+    const uint64_t work = (i==S_Recursive ? 2 : s->calls);
+    CHECK(s->excl>=work*dat.sym[i].workUs*1000);
+    excl += s->excl;
+    }
+  // root frames are startup and outermost recursive call
+  CHECK(excl>=prof.stats(S_Startup)->incl);
+  CHECK(excl<=prof.stats(S_Startup)->incl+prof.stats(S_Recursive)->incl);
+  CHECK(prof.stats(S_AiState)->incl>=prof.stats(S_AiState)->excl+prof.stats(S_Condition)->incl);
+  }
+
+// nested frames of recursive function are not counted twice into inclusive time
+static void recursion() {
+  using Clock = std::chrono::steady_clock;
+  ScriptProfiler prof("");
+  auto t0 = Clock::now();
+  prof.enter(S_Recursive,"B_RECURSIVE");
+  prof.enter(S_Recursive,"B_RECURSIVE");
+  StubDat::spin(2000);
+  prof.leave();
+  prof.leave();
+  auto wall = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now()-t0).count());
+
+  auto s = prof.stats(S_Recursive);
+  CHECK(s->calls==2);
+  CHECK(s->incl>=2000*1000);
+  CHECK(s->incl<=wall);
+  CHECK(s->excl<=wall);
+  }
+
+static size_t countEvents(const std::string& file) {
+  std::ifstream fin(file);
+  std::string   ln;
+  size_t        n=0;
+  while(std::getline(fin,ln))
+    if(ln.find("\"ph\":\"X\"")!=std::string::npos)
+      ++n;
+  return n;
+  }
+
+// each session gets own file; event buffer is capped by configured limit
+static void traceSessions() {
+  auto dat = scenario();
+
+  ScriptProfiler a("scriptprofiler_test.json");
+  ScriptProfiler b("scriptprofiler_test.json",5);
+  CHECK(a.traceFileName()!=b.traceFileName());
+  CHECK(a.traceFileName().rfind(".json")==a.traceFileName().size()-5);
+
+  runScenario(dat,a);
+  runScenario(dat,b);
+  CHECK(a.writeTrace());
+  CHECK(b.writeTrace());
+
+  // 1+3*3+1 from startup, 3 recursive frames
+  CHECK(countEvents(a.traceFileName())==14);
+  CHECK(countEvents(b.traceFileName())==5);
+
+  std::ifstream fin(a.traceFileName());
+  std::string   all((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+  CHECK(all.find("\"name\":\"ZS_TALK\"")!=std::string::npos);
+
+  // no trace file requested - nothing written
+  ScriptProfiler c("");
+  CHECK(c.traceFileName().empty());
+  CHECK(c.writeTrace());
+  }
+
+int main() {
+  callStats();
+  recursion();
+  traceSessions();
+  return Test::result("scriptprofiler");
+  }
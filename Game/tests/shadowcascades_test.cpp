@@ -0,0 +1,123 @@
+#include "test.h"
+
+#include <cmath>
+
+#include "graphics/shadowcascades.h"
+
+using namespace Tempest;
+
+static const uint32_t            smSize = 2048;
+static const std::array<float,3> sunDir = {{0.3f,-1.f,0.2f}};
+
+static Matrix4x4 mkProj() {
+  Matrix4x4 proj;
+  proj.perspective(45.f, 16.f/9.f, 10.f, 20000.f);
+  return proj;
+  }
+
+// camera in 'x', looking along +z
+static Matrix4x4 mkView(float x) {
+  Matrix4x4 view;
+  view.identity();
+  view.translate(-x,0,0);
+  return view;
+  }
+
+static Vec3 project(const Matrix4x4& m, Vec3 p) {
+  m.project(p.x,p.y,p.z);
+  return p;
+  }
+
+static void splitsAreMonotonic() {
+  ShadowCascades sh(smSize);
+  float prev = 0;
+  for(size_t i=0;i<ShadowCascades::CASCADES;++i) {
+    CHECK(sh.splitDistance(i)>prev);
+    prev = sh.splitDistance(i);
+    }
+  }
+
+// every point of a frustum slice is inside of light-space box of it's cascade
+static void sliceContainment() {
+  ShadowCascades sh(smSize);
+  const auto proj = mkProj();
+  const auto view = mkView(1234.f);
+  sh.update(view,proj,sunDir);
+
+  auto inv = proj;
+  inv.mul(view);
+  inv.inverse();
+
+  const float eps = 1e-3f;
+  for(size_t layer=0;layer<ShadowCascades::CASCADES;++layer) {
+    const float d0 = layer==0 ? 60.f : sh.splitDistance(layer-1);
+    const float d1 = sh.splitDistance(layer);
+    for(int i=0;i<=8;++i)
+      for(int r=0;r<=8;++r) {
+        // ray through point of the screen, scaled to view depth
+        Vec3 a = project(inv,Vec3(float(i)/4.f-1.f,float(r)/4.f-1.f,0.5f));
+        Vec3 c(1234.f,0,0);
+        Vec3 dir = a-c;
+        dir = dir*(1.f/dir.z);
+        for(float d:{d0,(d0+d1)*0.5f,d1}) {
+          Vec3 p = project(sh.matrix()[layer],c+dir*d);
+          CHECK(p.x>=-1.f-eps && p.x<=1.f+eps);
+          CHECK(p.y>=-1.f-eps && p.y<=1.f+eps);
+          CHECK(p.z>=-eps     && p.z<=1.f+eps);
+          }
+        }
+    }
+  }
+
+// camera movement shifts the near cascade only by whole texels: a fixed point stays on the same sub-texel offset
+static void texelSnap() {
+  ShadowCascades sh(smSize);
+  const auto proj  = mkProj();
+  const Vec3 pt(1000.f,-50.f,700.f);
+  const float texel = 2.f/float(smSize);
+
+  sh.update(mkView(0.f),proj,sunDir);
+  const Matrix4x4 m0 = sh.matrix()[0];
+  const Vec3      p0 = project(m0,pt);
+
+  for(float x:{0.37f,1.9f,13.f,155.5f}) {
+    sh.update(mkView(x),proj,sunDir);
+    const Matrix4x4& m = sh.matrix()[0];
+    for(int c=0;c<3;++c)
+      for(int r=0;r<3;++r)
+        CHECK(std::fabs(m.at(c,r)-m0.at(c,r))<1e-6f);
+
+    const Vec3 p  = project(m,pt);
+    const float tx = (p.x-p0.x)/texel;
+    const float ty = (p.y-p0.y)/texel;
+    CHECK(std::fabs(tx-std::round(tx))<1e-2f);
+    CHECK(std::fabs(ty-std::round(ty))<1e-2f);
+    }
+  }
+
+// culling of casters against cascade box
+static void casterVisibility() {
+  ShadowCascades sh(smSize);
+  sh.update(mkView(0.f),mkProj(),sunDir);
+  const auto& m = sh.matrix()[0];
+
+  const Vec3 inside(0,0,sh.splitDistance(0)*0.5f);
+  CHECK(ShadowCascades::isVisible(m,inside,1.f));
+  CHECK(!ShadowCascades::isVisible(m,Vec3(100000.f,0,0),10.f));
+  // far away, but big enough to reach the box
+  CHECK(ShadowCascades::isVisible(m,Vec3(100000.f,0,0),200000.f));
+  // behind the camera, but between camera and sun: casts into the slice
+  const Vec3 towardsSun = inside + Vec3(-sunDir[0],-sunDir[1],-sunDir[2])*1000.f;
+  CHECK(ShadowCascades::isVisible(m,towardsSun,1.f));
+  // below the slice, away from the sun: can't cast into it
+  const Vec3 belowSlice = inside + Vec3(sunDir[0],sunDir[1],sunDir[2])*100000.f;
+  CHECK(!ShadowCascades::isVisible(m,belowSlice,1.f));
+  }
+
+int main() {
+  splitsAreMonotonic();
+  sliceContainment();
+  texelSnap();
+  casterVisibility();
+  return Test::result("shadowcascades");
+  }
@@ -0,0 +1,327 @@
+#include "test.h"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "dmusic/dlscollection.h"
+#include "dmusic/hydra.h"
+#include "dmusic/riff.h"
+#include "dmusic/soundfont.h"
+#include "dmusic/wave.h"
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include "tsf.h"
+#pragma GCC diagnostic pop
+#else
+#include "tsf.h"
+#endif
+
+using namespace Dx8;
+
+using Bytes = std::vector<uint8_t>;
+
+static void put(Bytes& out, const void* data, size_t size) {
+  auto p = reinterpret_cast<const uint8_t*>(data);
+  out.insert(out.end(),p,p+size);
+  }
+
+static Bytes chunk(const char* id, const Bytes& body) {
+  Bytes    ret;
+  uint32_t sz = uint32_t(body.size());
+  put(ret,id,4);
+  put(ret,&sz,4);
+  put(ret,body.data(),body.size());
+  if(sz%2)
+    ret.push_back(0);
+  return ret;
+  }
+
+static Bytes list(const char* id, const char* listId, const std::vector<Bytes>& child) {
+  Bytes body;
+  put(body,listId,4);
+  for(auto& c:child)
+    put(body,c.data(),c.size());
+  return chunk(id,body);
+  }
+
+template<class T>
+static Bytes pod(const T& t) {
+  Bytes ret;
+  put(ret,&t,sizeof(t));
+  return ret;
+  }
+
+// one second of looped mono sine, 16 bit
+static Bytes mkWave(float freq) {
+  Wave::WaveFormat fmt;
+  fmt.wFormatTag       = Wave::PCM;
+  fmt.wChannels        = 1;
+  fmt.dwSamplesPerSec  = SoundFont::SampleRate;
+  fmt.dwAvgBytesPerSec = SoundFont::SampleRate*2;
+  fmt.wBlockAlign      = 2;
+  fmt.wBitsPerSample   = 16;
+
+  std::vector<int16_t> pcm(SoundFont::SampleRate);
+  for(size_t i=0;i<pcm.size();++i)
+    pcm[i] = int16_t(std::sin(float(i)*freq*6.2831853f/float(SoundFont::SampleRate))*12000.f);
+
+  Bytes data;
+  put(data,pcm.data(),pcm.size()*sizeof(int16_t));
+  return list("LIST","wave",{chunk("fmt ",pod(fmt)),chunk("data",data)});
+  }
+
+static Bytes mkRegion(uint16_t lo, uint16_t hi, uint32_t wave) {
+  DlsCollection::RegionHeader rgnh;
+  rgnh.RangeKey.usLow  = lo;
+  rgnh.RangeKey.usHigh = hi;
+
+  DlsCollection::WaveLink wlnk;
+  wlnk.ulTableIndex = wave;
+
+  DlsCollection::WaveSample wsmp;
+  wsmp.cbSize       = sizeof(wsmp);
+  wsmp.usUnityNote  = 60;
+  wsmp.cSampleLoops = 1;
+
+  DlsCollection::WaveSampleLoop loop;
+  loop.cbSize       = sizeof(loop);
+  loop.ulLoopLength = SoundFont::SampleRate;
+
+  Bytes smp = pod(wsmp);
+  put(smp,&loop,sizeof(loop));
+  return list("LIST","rgn ",{chunk("rgnh",pod(rgnh)),chunk("wlnk",pod(wlnk)),chunk("wsmp",smp)});
+  }
+
+// synthetic collection: one instrument, two looped waves split at middle C
+static Bytes mkDls() {
+  DlsCollection::InstrumentHeader insh;
+  insh.cRegions = 2;
+
+  Bytes ins = list("LIST","ins ",{chunk("insh",pod(insh)),
+                                  list("LIST","lrgn",{mkRegion(0,59,0),mkRegion(60,127,1)})});
+  return list("RIFF","DLS ",{list("LIST","wvpl",{mkWave(220.f),mkWave(330.f)}),
+                             list("LIST","lins",{ins})});
+  }
+
+static std::vector<Wave> mkWaves(const Bytes& dls) {
+  std::vector<Wave> ret;
+  Riff input(dls.data(),dls.size());
+  input.readListId("DLS ");
+  input.read([&ret](Riff& c){
+    if(c.is("LIST") && c.isListId("wvpl"))
+      c.read([&ret](Riff& w){ ret.emplace_back(w); });
+    });
+  return ret;
+  }
+
+// pre-pooling synthesizer: linear scan over clones, fresh tsf per clone; used as golden render
+struct Reference final {
+  struct Instance final {
+    explicit Instance(Hydra& h) {
+      fnt    = h.toTsf();
+      preset = tsf_get_presetindex(fnt,0,0);
+      tsf_set_output(fnt,TSF_STEREO_INTERLEAVED,SoundFont::SampleRate,0);
+      tsf_channel_set_pan(fnt,0,0.5f);
+      tsf_channel_set_pan(fnt,1,0.5f);
+      }
+    ~Instance() { Hydra::finalize(fnt); }
+
+    std::bitset<256> alloc;
+    tsf*             fnt=nullptr;
+    int              preset=0;
+    };
+
+  explicit Reference(Hydra& h):hydra(h) {}
+
+  Instance* noteOn(uint8_t note, uint8_t vel) {
+    for(auto& i:inst)
+      if(!i->alloc[note]) {
+        i->alloc[note] = true;
+        tsf_note_on(i->fnt,i->preset,note,(vel+0.5f)/127.f);
+        return i.get();
+        }
+    inst.emplace_back(new Instance(hydra));
+    return noteOn(note,vel);
+    }
+
+  static void noteOff(Instance* i, uint8_t note) {
+    i->alloc[note] = false;
+    tsf_note_off(i->fnt,i->preset,note);
+    }
+
+  void mix(float* out, size_t count) {
+    for(auto& i:inst)
+      tsf_render_float(i->fnt,out,int(count),true);
+    }
+
+  Hydra&                                 hydra;
+  std::vector<std::unique_ptr<Instance>> inst;
+  };
+
+struct Event final {
+  uint32_t block;
+  uint8_t  note;
+  bool     on;
+  };
+
+// chords with retriggered notes: same note held twice forces a second synthesizer clone
+static std::vector<Event> mkPattern(uint32_t bars) {
+  static const uint8_t chord[4][3] = {{48,60,64},{53,60,65},{55,59,67},{48,60,64}};
+  std::vector<Event> ev;
+  for(uint32_t b=0;b<bars;++b) {
+    auto& c  = chord[b%4];
+    uint32_t t = b*64;
+    for(auto n:c) {
+      ev.push_back({t,    n,true });
+      ev.push_back({t+48, n,false});
+      }
+    // retrigger of the middle note while it still sounds
+    ev.push_back({t+16,c[1],true });
+    ev.push_back({t+56,c[1],false});
+    }
+  std::stable_sort(ev.begin(),ev.end(),[](const Event& a,const Event& b){ return a.block<b.block; });
+  return ev;
+  }
+
+enum { Block = 256 };
+
+// plays pattern, noteOff goes to the oldest sounding noteOn of same note
+template<class On,class Off,class Mix>
+static std::vector<float> render(const std::vector<Event>& ev, uint32_t blocks, On on, Off off, Mix mix) {
+  std::vector<float> out(size_t(blocks)*Block*2);
+  size_t e=0;
+  for(uint32_t b=0;b<blocks;++b) {
+    for(;e<ev.size() && ev[e].block==b;++e) {
+      if(ev[e].on)
+        on(ev[e].note); else
+        off(ev[e].note);
+      }
+    mix(&out[size_t(b)*Block*2],size_t(Block));
+    }
+  return out;
+  }
+
+static std::vector<float> renderPooled(const DlsCollection& dls, const std::vector<Event>& ev, uint32_t blocks) {
+  SoundFont                                  sf = dls.toSoundfont(0);
+  std::vector<std::vector<SoundFont::Ticket>> held(256);
+  sf.setPan(0.5f);
+  return render(ev,blocks,
+    [&](uint8_t n){ held[n].push_back(sf.noteOn(n,100)); },
+    [&](uint8_t n){ SoundFont::noteOff(held[n].front()); held[n].erase(held[n].begin()); },
+    [&](float* out,size_t cnt){ sf.mix(out,cnt); });
+  }
+
+static std::vector<float> renderReference(Hydra& hydra, const std::vector<Event>& ev, uint32_t blocks) {
+  Reference                                      ref(hydra);
+  std::vector<std::vector<Reference::Instance*>> held(256);
+  return render(ev,blocks,
+    [&](uint8_t n){ held[n].push_back(ref.noteOn(n,100)); },
+    [&](uint8_t n){ Reference::noteOff(held[n].front(),n); held[n].erase(held[n].begin()); },
+    [&](float* out,size_t cnt){ ref.mix(out,cnt); });
+  }
+
+static float maxDiff(const std::vector<float>& a, const std::vector<float>& b) {
+  float ret = 0;
+  for(size_t i=0;i<a.size() && i<b.size();++i)
+    ret = std::max(ret,std::abs(a[i]-b[i]));
+  return ret;
+  }
+
+static uint32_t checksum(const std::vector<float>& pcm) {
+  uint32_t h = 2166136261u;
+  for(auto f:pcm) {
+    auto s = int16_t(std::max(-1.f,std::min(f,1.f))*32767.f);
+    h = (h^uint16_t(s))*16777619u;
+    }
+  return h;
+  }
+
+// pooled clones produce same signal as golden linear-scan render; only summation order of clones may differ
+static void goldenRender() {
+  const Bytes   bytes = mkDls();
+  Riff          riff(bytes.data(),bytes.size());
+  DlsCollection dls(riff);
+  auto          wave = mkWaves(bytes);
+  Hydra         hydra(dls,wave);
+
+  const auto     ev     = mkPattern(8);
+  const uint32_t blocks = 8*64+200;
+  auto pooled = renderPooled(dls,ev,blocks);
+  auto golden = renderReference(hydra,ev,blocks);
+
+  float energy = 0;
+  for(auto f:golden)
+    energy += f*f;
+  const float diff = maxDiff(pooled,golden);
+  CHECK(energy>1.f);
+  CHECK(pooled.size()==golden.size());
+  CHECK(diff<1e-4f);
+
+  // release tails are done: output ends in silence
+  for(size_t i=golden.size()-Block*2;i<golden.size();++i)
+    CHECK(pooled[i]==0.f);
+  std::printf("golden render: checksum %08x, pooled %08x, max diff %g\n",
+              unsigned(checksum(golden)),unsigned(checksum(pooled)),double(diff));
+  }
+
+// two themes in a row on same collection: waves are decoded once per collection,
+// second theme reuses idle synthesizer clones of first one and sounds the same
+static void decodeOnce() {
+  const Bytes   bytes    = mkDls();
+  const auto    decoded0 = SoundFont::decodedWaves();
+  Riff          riff(bytes.data(),bytes.size());
+  DlsCollection dls(riff);
+  CHECK(SoundFont::decodedWaves()-decoded0==2);
+
+  const auto     ev     = mkPattern(2);
+  const uint32_t blocks = 2*64+200;
+
+  const auto built0 = SoundFont::builtPresets();
+  auto theme1 = renderPooled(dls,ev,blocks);
+  const auto built1 = SoundFont::builtPresets();
+  CHECK(built1-built0==2);
+
+  auto theme2 = renderPooled(dls,ev,blocks);
+  CHECK(SoundFont::builtPresets()==built1);
+  CHECK(SoundFont::decodedWaves()-decoded0==2);
+  CHECK(theme1.size()==theme2.size());
+  CHECK(maxDiff(theme1,theme2)<1e-4f);
+  }
+
+// longer dense pattern: time per render path
+static void benchmark() {
+  using Clock = std::chrono::steady_clock;
+  const Bytes   bytes = mkDls();
+  Riff          riff(bytes.data(),bytes.size());
+  DlsCollection dls(riff);
+  auto          wave = mkWaves(bytes);
+  Hydra         hydra(dls,wave);
+
+  const auto     ev     = mkPattern(64);
+  const uint32_t blocks = 64*64+200;
+
+  auto t0 = Clock::now();
+  auto pooled = renderPooled(dls,ev,blocks);
+  auto t1 = Clock::now();
+  auto golden = renderReference(hydra,ev,blocks);
+  auto t2 = Clock::now();
+
+  CHECK(pooled.size()==golden.size());
+  auto ms  = [](Clock::duration d){ return double(std::chrono::duration_cast<std::chrono::microseconds>(d).count())/1000.0; };
+  auto sec = double(blocks)*Block/SoundFont::SampleRate;
+  std::printf("%.1f sec of music: pooled %.3f ms, linear scan %.3f ms\n",sec,ms(t1-t0),ms(t2-t1));
+  }
+
+int main() {
+  goldenRender();
+  decodeOnce();
+  benchmark();
+  return Test::result("soundfont");
+  }
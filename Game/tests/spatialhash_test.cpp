@@ -0,0 +1,169 @@
+#include "test.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "world/spatialhash.h"
+
+struct Obj final {
+  Tempest::Vec3 pos;
+  const Tempest::Vec3& position() const { return pos; }
+  };
+
+static std::vector<Obj*> bruteForce(std::vector<std::unique_ptr<Obj>>& obj, const Tempest::Vec3& p, float R) {
+  std::vector<Obj*> ret;
+  for(auto& i:obj)
+    if((i->pos-p).quadLength()<R*R)
+      ret.push_back(i.get());
+  std::sort(ret.begin(),ret.end());
+  return ret;
+  }
+
+static std::vector<Obj*> query(const SpatialHash<Obj>& h, const Tempest::Vec3& p, float R) {
+  std::vector<Obj*> ret;
+  h.find(p.x,p.y,p.z,R,[&ret](Obj& o){ ret.push_back(&o); });
+  std::sort(ret.begin(),ret.end());
+  return ret;
+  }
+
+static void randomWorld(std::vector<std::unique_ptr<Obj>>& obj, SpatialHash<Obj>& h, size_t count, std::mt19937& rnd) {
+  std::uniform_real_distribution<float> xz(-50000.f,50000.f), y(-500.f,500.f);
+  for(size_t i=0;i<count;++i) {
+    obj.emplace_back(new Obj());
+    obj.back()->pos = Tempest::Vec3(xz(rnd),y(rnd),xz(rnd));
+    h.insert(*obj.back());
+    }
+  }
+
+// same result as linear scan, for small, cell-sized and world-sized radius
+static void matchesBruteForce() {
+  std::mt19937                      rnd(1);
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  randomWorld(obj,h,500,rnd);
+
+  std::uniform_real_distribution<float> xz(-50000.f,50000.f);
+  for(float R:{10.f,999.f,1000.f,3000.f,200000.f})
+    for(int i=0;i<50;++i) {
+      Tempest::Vec3 p(xz(rnd),0,xz(rnd));
+      CHECK(query(h,p,R)==bruteForce(obj,p,R));
+      }
+  }
+
+// moved and erased objects are found in new place only
+static void updateAndErase() {
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  for(int i=0;i<4;++i) {
+    obj.emplace_back(new Obj());
+    h.insert(*obj.back());
+    }
+  obj[0]->pos = Tempest::Vec3(5000,0,5000);
+  h.update(*obj[0]);
+  h.erase(*obj[1]);
+
+  CHECK(h.size()==3);
+  CHECK(query(h,Tempest::Vec3(),100.f).size()==2);
+  auto far = query(h,Tempest::Vec3(5000,0,5000),100.f);
+  CHECK(far.size()==1 && far[0]==obj[0].get());
+  }
+
+// callback moves every object it sees to other cell: each match is reported once, index stays consistent
+static void mutationInCallback() {
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  for(int i=0;i<64;++i) {
+    obj.emplace_back(new Obj());
+    obj.back()->pos = Tempest::Vec3(float(i%8)*100.f,0,float(i/8)*100.f);
+    h.insert(*obj.back());
+    }
+
+  size_t calls=0;
+  h.find(350,0,350,2000,[&](Obj& o){
+    ++calls;
+    o.pos.x += 100000.f;
+    h.update(o);
+    });
+  CHECK(calls==obj.size());
+  CHECK(h.size()==obj.size());
+  CHECK(query(h,Tempest::Vec3(350,0,350),2000).empty());
+  CHECK(query(h,Tempest::Vec3(100350,0,350),2000).size()==obj.size());
+  }
+
+// hits come in insertion order, whatever cells they are in; moving keeps position in order
+static void insertionOrder() {
+  std::mt19937                      rnd(3);
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  randomWorld(obj,h,300,rnd);
+  obj[10]->pos = Tempest::Vec3(40000,0,40000);
+  h.update(*obj[10]);
+  h.erase(*obj[20]);
+
+  for(float R:{3000.f,30000.f,200000.f}) {
+    std::vector<Obj*> got, expect;
+    h.find(0,0,0,R,[&got](Obj& o){ got.push_back(&o); });
+    for(size_t i=0;i<obj.size();++i)
+      if(i!=20 && obj[i]->pos.quadLength()<R*R)
+        expect.push_back(obj[i].get());
+    CHECK(got==expect);
+    }
+  }
+
+// nested query from callback does not disturb outer one
+static void nestedFind() {
+  std::mt19937                      rnd(4);
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  randomWorld(obj,h,200,rnd);
+
+  std::vector<Obj*> outer;
+  size_t            inner=0, expectInner=0;
+  h.find(0,0,0,30000,[&](Obj& o){
+    outer.push_back(&o);
+    h.find(o.pos.x,o.pos.y,o.pos.z,5000,[&inner](Obj&){ ++inner; });
+    expectInner += query(h,o.pos,5000).size();
+    });
+  CHECK(outer.size()==query(h,Tempest::Vec3(),30000).size());
+  CHECK(inner==expectInner);
+  }
+
+// synthetic world of 2000 npc, each doing detect query in perception range
+static void benchmark() {
+  using Clock = std::chrono::steady_clock;
+  std::mt19937                      rnd(2);
+  std::vector<std::unique_ptr<Obj>> obj;
+  SpatialHash<Obj>                  h;
+  randomWorld(obj,h,2000,rnd);
+
+  const float R = 2000.f;
+  size_t hitH=0, hitL=0;
+
+  auto t0 = Clock::now();
+  for(auto& i:obj)
+    h.find(i->pos.x,i->pos.y,i->pos.z,R,[&hitH](Obj&){ ++hitH; });
+  auto t1 = Clock::now();
+  for(auto& i:obj)
+    for(auto& n:obj)
+      if((n->pos-i->pos).quadLength()<R*R)
+        ++hitL;
+  auto t2 = Clock::now();
+
+  CHECK(hitH==hitL);
+  auto us = [](Clock::duration d){ return double(std::chrono::duration_cast<std::chrono::microseconds>(d).count())/1000.0; };
+  std::printf("2000 npc detect: spatial hash %.3f ms, linear scan %.3f ms (%u matches)\n",
+              us(t1-t0),us(t2-t1),unsigned(hitH));
+  }
+
+int main() {
+  matchesBruteForce();
+  updateAndErase();
+  mutationInCallback();
+  insertionOrder();
+  nestedFind();
+  benchmark();
+  return Test::result("spatialhash");
+  }
@@ -0,0 +1,184 @@
+#include "test.h"
+
+#include <chrono>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "datwriter.h"
+#include "game/definitions/spelldefinitions.h"
+
+using C_Spell = Daedalus::GEngineClasses::C_Spell;
+
+static const char* const fxNames[] = {"Light","Firebolt","Icebolt","Unknown"};
+
+enum { Fillers = 100 };
+
+// spells of spellFxInstanceNames, preceded by fillers, so linear scan has work to do;
+// damage_per_level tells spells apart: 1+index in fxNames, 1000+index for fillers
+static std::unique_ptr<Daedalus::DaedalusVM> mkVm() {
+  DatWriter dat;
+  auto cls = dat.klass("C_SPELL");
+  auto dpl = dat.member(cls,"DAMAGE_PER_LEVEL",DatWriter::T_Int);
+  dat.member(cls,"SPELLTYPE",DatWriter::T_Int);
+
+  for(int i=0;i<Fillers;++i) {
+    dat.instance(("SPELL_FILLER_"+std::to_string(i)).c_str(),cls);
+    dat.setInt(dpl,1000+i);
+    dat.end();
+    }
+  for(int i=0;i<3;++i) {
+    std::string name = std::string("SPELL_")+fxNames[i];
+    for(auto& c:name)
+      c = char(std::toupper(c));
+    dat.instance(name.c_str(),cls);
+    dat.setInt(dpl,1+i);
+    dat.end();
+    }
+  dat.constString("SPELLFXINSTANCENAMES",{fxNames[0],fxNames[1],fxNames[2],fxNames[3]});
+
+  // cast functions return 11+id; Firebolt has none
+  dat.func("SPELL_CAST_LIGHT");
+  dat.ret(11);
+  dat.func("SPELL_CAST_ICEBOLT");
+  dat.ret(13);
+  return dat.vm();
+  }
+
+// lookup of SpellDefinitions before name index: formatted name is compared with every instance
+struct Reference final {
+  struct Spell:C_Spell {
+    std::string instName;
+    };
+
+  explicit Reference(Daedalus::DaedalusVM& vm):vm(vm) {
+    size_t count=0;
+    vm.getDATFile().iterateSymbolsOfClass("C_Spell",[&count](size_t,Daedalus::PARSymbol&){
+      ++count;
+      });
+    spl.resize(count);
+    count=0;
+    vm.getDATFile().iterateSymbolsOfClass("C_Spell",[&](size_t i,Daedalus::PARSymbol& p){
+      vm.initializeInstance(spl[count],i,Daedalus::IC_Spell);
+      spl[count].instName = p.name;
+      ++count;
+      });
+    }
+
+  ~Reference() {
+    vm.clearReferences(Daedalus::IC_Spell);
+    }
+
+  const C_Spell& find(const char* instanceName) const {
+    char format[64]={};
+    std::snprintf(format,sizeof(format),"SPELL_%s",instanceName);
+    for(auto& i:format)
+      i = char(std::toupper(i));
+    for(auto& i:spl)
+      if(i.instName==format)
+        return i;
+    static C_Spell szero={};
+    return szero;
+    }
+
+  Daedalus::DaedalusVM& vm;
+  std::vector<Spell>    spl;
+  };
+
+// any spelling of instance name resolves to same spell; ids follow spellFxInstanceNames
+static void lookup() {
+  auto             vm = mkVm();
+  SpellDefinitions spells(*vm);
+
+  CHECK(spells.find("Light").damage_per_level==1);
+  CHECK(&spells.find("LIGHT")==&spells.find("Light"));
+  CHECK(&spells.find("light")==&spells.find("Light"));
+  CHECK(&spells.find("fIrEbOlT")==&spells.find("Firebolt"));
+  CHECK(spells.find("Icebolt").damage_per_level==3);
+  CHECK(spells.find("Filler_7").damage_per_level==1007);
+
+  for(int32_t id=0;id<3;++id) {
+    CHECK(&spells.find(id)==&spells.find(fxNames[id]));
+    CHECK(spells.find(id).damage_per_level==1+id);
+    }
+
+  // not defined by script: shared empty spell
+  CHECK(spells.find("Unknown").damage_per_level==0);
+  CHECK(&spells.find(3)==&spells.find(-1));
+  CHECK(&spells.find(4)==&spells.find(-1));
+  CHECK(spells.find(100).damage_per_level==0);
+  CHECK(spells.find("").damage_per_level==0);
+  }
+
+// every name of script resolves to same spell as old scan
+static void sameAsReference() {
+  auto             vm = mkVm();
+  Reference        ref(*vm);
+  SpellDefinitions spells(*vm);
+  for(auto n:fxNames)
+    CHECK(spells.find(n).damage_per_level==ref.find(n).damage_per_level);
+  for(int i=0;i<Fillers;++i) {
+    auto n = "filler_"+std::to_string(i);
+    CHECK(spells.find(n.c_str()).damage_per_level==ref.find(n.c_str()).damage_per_level);
+    }
+  }
+
+// cast functions and effect names are resolved with spell table; callers only pass spell id
+static void castAndVfx() {
+  auto             vm = mkVm();
+  SpellDefinitions spells(*vm);
+  auto&            dat = vm->getDATFile();
+
+  CHECK(spells.castFunc(0)==dat.getSymbolIndexByName("SPELL_CAST_LIGHT"));
+  CHECK(spells.castFunc(2)==dat.getSymbolIndexByName("SPELL_CAST_ICEBOLT"));
+  CHECK(vm->runFunctionBySymIndex(spells.castFunc(0))==11);
+  CHECK(vm->runFunctionBySymIndex(spells.castFunc(2))==13);
+  CHECK(spells.castFunc(1)==size_t(-1));
+  CHECK(spells.castFunc(3)==size_t(-1));
+  CHECK(spells.castFunc(4)==size_t(-1));
+  CHECK(spells.castFunc(-1)==size_t(-1));
+
+  CHECK(spells.vfxNames().size()==4);
+  CHECK(std::string(spells.vfxName(0))=="spellFX_Light");
+  CHECK(std::string(spells.vfxName(3))=="spellFX_Unknown");
+  CHECK(spells.vfxName(4)==nullptr);
+  CHECK(spells.vfxName(-1)==nullptr);
+  for(int32_t id=0;id<4;++id)
+    CHECK(spells.vfxNames()[size_t(id)]==spells.vfxName(id));
+  }
+
+// 10k resolves, by name and by id, against old scan
+static void benchmark() {
+  using Clock = std::chrono::steady_clock;
+  enum { Count = 10000 };
+  auto             vm = mkVm();
+  Reference        ref(*vm);
+  SpellDefinitions spells(*vm);
+
+  int32_t sum[3] = {};
+  auto t0 = Clock::now();
+  for(int i=0;i<Count;++i)
+    sum[0] += ref.find(fxNames[i%3]).damage_per_level;
+  auto t1 = Clock::now();
+  for(int i=0;i<Count;++i)
+    sum[1] += spells.find(fxNames[i%3]).damage_per_level;
+  auto t2 = Clock::now();
+  for(int i=0;i<Count;++i)
+    sum[2] += spells.find(int32_t(i%3)).damage_per_level;
+  auto t3 = Clock::now();
+
+  CHECK(sum[0]==sum[1]);
+  CHECK(sum[0]==sum[2]);
+  auto us = [](Clock::duration d){ return double(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count())/1000.0; };
+  std::printf("%d resolves of %d spells: scan %.1f us, by name %.1f us, by id %.1f us\n",
+              int(Count),int(Fillers+3),us(t1-t0),us(t2-t1),us(t3-t2));
+  }
+
+int main() {
+  lookup();
+  sameAsReference();
+  castAndVfx();
+  benchmark();
+  return Test::result("spelldefinitions");
+  }
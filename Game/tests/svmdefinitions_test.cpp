@@ -0,0 +1,109 @@
+#include "test.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "datwriter.h"
+#include "game/definitions/svmdefinitions.h"
+
+static const char* const lines[] = {"SMALLTALK01","SMALLTALK02","WEATHER"};
+
+// two voices; voice 1 leaves one of lines empty, voice 2 is not defined
+static std::unique_ptr<Daedalus::DaedalusVM> mkVm() {
+  DatWriter dat;
+  auto cls = dat.klass("C_SVM");
+  size_t mem[3]={};
+  for(size_t i=0;i<3;++i)
+    mem[i] = dat.member(cls,lines[i],DatWriter::T_String);
+
+  dat.instance("SVM_0",cls);
+  dat.setString(mem[0],"$SVM_0_SMALLTALK01");
+  dat.setString(mem[1],"$SVM_0_SMALLTALK02");
+  dat.setString(mem[2],"$SVM_0_WEATHER");
+  dat.end();
+
+  dat.instance("SVM_1",cls);
+  dat.setString(mem[0],"$SVM_1_SMALLTALK01");
+  dat.setString(mem[2],"$SVM_1_WEATHER");
+  dat.end();
+  return dat.vm();
+  }
+
+// lookup of SvmDefinitions before per-voice tables: instance and member symbol are resolved by name on each call
+struct Reference final {
+  Daedalus::DaedalusVM&                                          vm;
+  std::vector<std::unique_ptr<Daedalus::GEngineClasses::C_SVM>> svm;
+
+  ~Reference() {
+    vm.clearReferences(Daedalus::IC_Svm);
+    }
+
+  const Daedalus::ZString& find(const char* speech, int id) {
+    char name[128]={};
+    std::snprintf(name,sizeof(name),"SVM_%d",id);
+    if(svm.size()<=size_t(id))
+      svm.resize(size_t(id)+1);
+    if(svm[size_t(id)]==nullptr)
+      svm[size_t(id)].reset(new Daedalus::GEngineClasses::C_SVM());
+    if(svm[size_t(id)]->instanceSymbol==0)
+      vm.initializeInstance(*svm[size_t(id)],vm.getDATFile().getSymbolIndexByName(name),Daedalus::IC_Svm);
+
+    std::snprintf(name,sizeof(name),"C_SVM.%s",speech+1);
+    return vm.getDATFile().getSymbolByName(name).getString(0,svm[size_t(id)].get());
+    }
+  };
+
+static std::string str(const Daedalus::ZString& s) {
+  return s.c_str();
+  }
+
+static std::string expected(int id, const char* line) {
+  if(id==1 && std::strcmp(line,"SMALLTALK02")==0)
+    return "";
+  return "$SVM_"+std::to_string(id)+"_"+line;
+  }
+
+// every line of defined voices, in any lookup order, matches old lookup
+static void sameAsReference() {
+  auto vm = mkVm();
+  {
+  SvmDefinitions svm(*vm);
+  for(int pass=0;pass<2;++pass)
+    for(int id=1;id>=0;--id)
+      for(auto l:lines)
+        CHECK(str(svm.find((std::string("$")+l).c_str(),id))==expected(id,l));
+  }
+  {
+  Reference      ref{*vm,{}};
+  SvmDefinitions svm(*vm);
+  for(int id=0;id<2;++id)
+    for(auto l:lines) {
+      const std::string speech = std::string("$")+l;
+      CHECK(str(svm.find(speech.c_str(),id))==str(ref.find(speech.c_str(),id)));
+      }
+  }
+  }
+
+// names are case-insensitive like symbols of script; invalid requests give empty line
+static void invalidRequests() {
+  auto           vm = mkVm();
+  SvmDefinitions svm(*vm);
+  CHECK(str(svm.find("$smallTalk01",0))=="$SVM_0_SMALLTALK01");
+  CHECK(str(svm.find("$weather",1))=="$SVM_1_WEATHER");
+  CHECK(str(svm.find("$SMALLTALK02",1)).empty());
+  CHECK(str(svm.find("$NOSUCHLINE",0)).empty());
+  CHECK(str(svm.find("SMALLTALK01",0)).empty());
+  CHECK(str(svm.find(nullptr,0)).empty());
+  CHECK(str(svm.find("$SMALLTALK01",-1)).empty());
+  CHECK(str(svm.find("$SMALLTALK01",2)).empty());
+  CHECK(str(svm.find("$SMALLTALK01",100)).empty());
+  // undefined voice does not break later lookups of defined ones
+  CHECK(str(svm.find("$SMALLTALK01",1))=="$SVM_1_SMALLTALK01");
+  }
+
+int main() {
+  sameAsReference();
+  invalidRequests();
+  return Test::result("svmdefinitions");
+  }
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdio>
+
+// minimal assertion helpers for pure-CPU unit tests; each test is a standalone executable, run by ctest
+namespace Test {
+  inline int& failures() {
+    static int f=0;
+    return f;
+    }
+
+  inline void fail(const char* file, int line, const char* expr) {
+    std::fprintf(stderr,"%s:%d: check failed: %s\n",file,line,expr);
+    failures()++;
+    }
+
+  inline int result(const char* name) {
+    if(failures()==0)
+      std::printf("%s: ok\n",name); else
+      std::printf("%s: %d check(s) failed\n",name,failures());
+    return failures()==0 ? 0 : 1;
+    }
+  }
+
+#define CHECK(expr) do { if(!(expr)) Test::fail(__FILE__,__LINE__,#expr); } while(false)
@@ -0,0 +1,98 @@
+#include "test.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/tracer.h"
+
+struct Ev final {
+  std::string name;
+  int         tid=0;
+  double      ts =0;
+  double      dur=0;
+  };
+
+static std::vector<Ev> readTrace(const char* file) {
+  std::vector<Ev> ret;
+  std::ifstream   fin(file);
+  std::string     ln;
+  while(std::getline(fin,ln)) {
+    if(ln.find("\"ph\":\"X\"")==std::string::npos)
+      continue;
+    Ev e;
+    auto n   = ln.find("\"name\":\"")+8;
+    e.name   = ln.substr(n,ln.find('"',n)-n);
+    e.tid    = std::atoi(ln.c_str()+ln.find("\"tid\":")+6);
+    e.ts     = std::atof(ln.c_str()+ln.find("\"ts\":")+5);
+    e.dur    = std::atof(ln.c_str()+ln.find("\"dur\":")+6);
+    ret.push_back(e);
+    }
+  return ret;
+  }
+
+// ring keeps only most recent zones of a thread
+static void ringOverflow() {
+  const size_t ring = 64*1024;
+  for(size_t i=0;i<100;++i)
+    Tracer::Zone z("old");
+  for(size_t i=0;i<ring;++i)
+    Tracer::Zone z("new");
+
+  CHECK(Tracer::write("tracer_test_ring.json"));
+  auto ev = readTrace("tracer_test_ring.json");
+  CHECK(ev.size()==ring);
+  size_t old=0;
+  for(auto& e:ev)
+    if(e.name=="old")
+      old++;
+  CHECK(old==0);
+  }
+
+// events of all threads are merged by start time, enclosing zone goes first
+static void mergeOrder() {
+  auto worker = [](const char* name) {
+    Tracer::setThreadName(name);
+    for(int i=0;i<1000;++i) {
+      Tracer::Zone outer("outer");
+      Tracer::Zone inner("inner");
+      }
+    };
+  std::thread a(worker,"a"), b(worker,"b");
+  a.join();
+  b.join();
+
+  CHECK(Tracer::write("tracer_test_merge.json"));
+  auto ev = readTrace("tracer_test_merge.json");
+  CHECK(ev.size()==64*1024+4000);
+
+  for(size_t i=1;i<ev.size();++i)
+    CHECK(ev[i-1].ts<=ev[i].ts);
+
+  // per thread: each 'inner' has it's 'outer' listed before
+  std::vector<int> open(8,0);
+  for(auto& e:ev) {
+    if(e.tid<0 || size_t(e.tid)>=open.size())
+      continue;
+    if(e.name=="outer")
+      open[size_t(e.tid)]++;
+    if(e.name=="inner") {
+      CHECK(open[size_t(e.tid)]>0);
+      open[size_t(e.tid)]--;
+      }
+    }
+
+  std::ifstream fin("tracer_test_merge.json");
+  std::string   all((std::istreambuf_iterator<char>(fin)),std::istreambuf_iterator<char>());
+  CHECK(all.find("\"thread_name\"")!=std::string::npos);
+  CHECK(all.find("\"args\":{\"name\":\"a\"}")!=std::string::npos);
+  }
+
+int main() {
+  ringOverflow();
+  mergeOrder();
+  return Test::result("tracer");
+  }
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <mutex>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <string>
+#include <Tempest/Log>
+
+struct AssetCacheStats final {
+  const char* name   =nullptr;
+  size_t      count  =0;
+  size_t      bytes  =0;
+  uint64_t    hits   =0;
+  uint64_t    misses =0;
+  uint64_t    failed =0;
+  };
+
+template<class K,class V,class H=std::hash<K>>
+class AssetCache final {
+  public:
+    using SizeFn = size_t(*)(const V&);
+
+    AssetCache(const char* name, SizeFn sizeOf=nullptr):cacheName(name),sizeOf(sizeOf){}
+    AssetCache(const AssetCache&)=delete;
+
+    // returns cached value or calls 'load' once per key; concurrent requests of same key wait for the first one
+    // epoch==0 pins entry forever, otherwise entry may be evicted, once all users of that epoch are gone
+    // 'load' may request other keys; request of a key, that is being loaded by same thread, fails with nullptr
+    template<class F>
+    V* get(const K& key, uint64_t epoch, F&& load) {
+      Shard&                 s       = shard[H()(key)%SHARDS];
+      bool                   owner   = false;
+      bool                   reentry = false;
+      Entry*                 e       = nullptr;
+      std::promise<V*>       promise;
+      std::shared_future<V*> ready;
+      {
+      std::lock_guard<std::mutex> guard(s.sync);
+      auto it = s.data.find(key);
+      if(it!=s.data.end()) {
+        e       = &it->second;
+        ready   = e->ready;
+        reentry = std::find(inFlight().begin(),inFlight().end(),e)!=inFlight().end();
+        hits.fetch_add(1);
+        } else {
+        e        = &s.data[key];
+        ready    = promise.get_future().share();
+        e->ready = ready;
+        owner    = true;
+        misses.fetch_add(1);
+        }
+      touch(*e,epoch);
+      }
+      if(reentry) {
+        // waiting here would deadlock: promise is set by this thread, once outer 'load' returns
+        Tempest::Log::e("[",cacheName,"] recursive load of \"",keyName(key),"\"");
+        return nullptr;
+        }
+      if(!owner)
+        return ready.get();
+
+      // failed load is cached as well, so broken asset is not reloaded on every request
+      std::unique_ptr<V> v;
+      inFlight().push_back(e);
+      try {
+        v = load();
+        }
+      catch(const std::exception& err) {
+        Tempest::Log::e("[",cacheName,"] unable to load \"",keyName(key),"\": ",err.what());
+        }
+      catch(...) {
+        Tempest::Log::e("[",cacheName,"] unable to load \"",keyName(key),"\"");
+        }
+      inFlight().pop_back();
+      V*     ret = v.get();
+      size_t sz  = (v!=nullptr && sizeOf!=nullptr) ? sizeOf(*v) : 0;
+      if(v==nullptr)
+        failed.fetch_add(1);
+      {
+      std::lock_guard<std::mutex> guard(s.sync);
+      auto& e = s.data[key];
+      e.value = std::move(v);
+      e.bytes = sz;
+      }
+      bytes.fetch_add(sz);
+      promise.set_value(ret);
+      return ret;
+      }
+
+    // drops least recently used entries, that are not pinned and not used since 'epoch'
+    template<class F>
+    size_t evict(size_t budget, uint64_t epoch, F&& onEvict) {
+      return evict(budget,epoch,onEvict,[](const V&){ return false; });
+      }
+
+    // same, but entries for which 'keep' returns true stay resident - values still referenced from other caches
+    template<class F,class Keep>
+    size_t evict(size_t budget, uint64_t epoch, F&& onEvict, Keep&& keep) {
+      if(bytes.load()<=budget)
+        return 0;
+
+      struct Victim {
+        Shard*   s;
+        K        key;
+        uint64_t lastUse;
+        };
+      std::vector<Victim> victim;
+      for(auto& s:shard) {
+        std::lock_guard<std::mutex> guard(s.sync);
+        for(auto& i:s.data) {
+          auto& e = i.second;
+          // value==nullptr: load in progress or failed one, that stays cached
+          if(e.pinned || e.epoch>=epoch || e.value==nullptr || keep(*e.value))
+            continue;
+          victim.push_back(Victim{&s,i.first,e.lastUse});
+          }
+        }
+      std::sort(victim.begin(),victim.end(),[](const Victim& a,const Victim& b){
+        return a.lastUse<b.lastUse;
+        });
+
+      size_t freed = 0;
+      for(auto& v:victim) {
+        if(bytes.load()<=budget)
+          break;
+        std::unique_ptr<V> dead;
+        {
+        std::lock_guard<std::mutex> guard(v.s->sync);
+        auto it = v.s->data.find(v.key);
+        if(it==v.s->data.end() || it->second.pinned || it->second.epoch>=epoch)
+          continue;
+        dead = std::move(it->second.value);
+        bytes.fetch_sub(it->second.bytes);
+        freed += it->second.bytes;
+        v.s->data.erase(it);
+        }
+        // release of gpu-resources may take a while: keep shard unlocked for other loads
+        onEvict(*dead);
+        dead.reset();
+        }
+      return freed;
+      }
+
+    // visits all loaded values; 'fn' is called with shard locked and must not call back into cache
+    template<class F>
+    void forEach(F&& fn) {
+      for(auto& s:shard) {
+        std::lock_guard<std::mutex> guard(s.sync);
+        for(auto& i:s.data)
+          if(i.second.value!=nullptr)
+            fn(*i.second.value);
+        }
+      }
+
+    AssetCacheStats stats() {
+      AssetCacheStats st;
+      st.name   = cacheName;
+      st.bytes  = bytes.load();
+      st.hits   = hits.load();
+      st.misses = misses.load();
+      st.failed = failed.load();
+      for(auto& s:shard) {
+        std::lock_guard<std::mutex> guard(s.sync);
+        st.count += s.data.size();
+        }
+      return st;
+      }
+
+  private:
+    enum { SHARDS=16 };
+
+    struct Entry final {
+      std::shared_future<V*> ready;
+      std::unique_ptr<V>     value;
+      size_t                 bytes  =0;
+      uint64_t               lastUse=0;
+      uint64_t               epoch  =0;
+      bool                   pinned =false;
+      };
+
+    struct Shard final {
+      std::mutex                    sync;
+      std::unordered_map<K,Entry,H> data;
+      };
+
+    // entries, loaded by current thread; node of unordered_map is stable and in-flight entry is never evicted
+    static std::vector<const Entry*>& inFlight() {
+      static thread_local std::vector<const Entry*> e;
+      return e;
+      }
+
+    static const char* keyName(const std::string& k) { return k.c_str(); }
+    template<class T>
+    static const char* keyName(const T&) { return "?"; }
+
+    void touch(Entry& e,uint64_t epoch) {
+      e.lastUse = useCounter.fetch_add(1);
+      if(epoch==0)
+        e.pinned = true; else
+        e.epoch  = std::max(e.epoch,epoch);
+      }
+
+    const char*           cacheName=nullptr;
+    SizeFn                sizeOf=nullptr;
+    Shard                 shard[SHARDS];
+    std::atomic<size_t>   bytes{0};
+    std::atomic<uint64_t> hits{0}, misses{0}, failed{0}, useCounter{0};
+  };
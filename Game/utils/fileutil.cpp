@@ -8,6 +8,7 @@
 #include <shlwapi.h>
 #else
 #include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 bool FileUtil::exists(const std::u16string &path) {
@@ -19,3 +20,21 @@ bool FileUtil::exists(const std::u16string &path) {
   return stat(p.c_str(),&buffer)==0;
 #endif
   }
+
+bool FileUtil::mkdir(const std::u16string& path) {
+#ifdef __WINDOWS__
+  return CreateDirectoryW(reinterpret_cast<const WCHAR*>(path.c_str()),nullptr) || GetLastError()==ERROR_ALREADY_EXISTS;
+#else
+  std::string p=Tempest::TextCodec::toUtf8(path);
+  return ::mkdir(p.c_str(),0755)==0 || exists(path);
+#endif
+  }
+
+bool FileUtil::remove(const std::u16string& path) {
+#ifdef __WINDOWS__
+  return DeleteFileW(reinterpret_cast<const WCHAR*>(path.c_str())) || GetLastError()==ERROR_FILE_NOT_FOUND;
+#else
+  std::string p=Tempest::TextCodec::toUtf8(path);
+  return ::unlink(p.c_str())==0 || !exists(path);
+#endif
+  }
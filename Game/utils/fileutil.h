@@ -4,5 +4,7 @@
 
 namespace FileUtil {
   bool exists(const std::u16string& path);
+  bool mkdir (const std::u16string& path);
+  bool remove(const std::u16string& path);
   };
 
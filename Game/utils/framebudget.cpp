@@ -0,0 +1,82 @@
+#include "framebudget.h"
+
+const FrameBudget::Desc FrameBudget::desc[T_Count] = {
+  {0, 3}, // T_FarAnimation: every frame, every 2nd, every 4th
+  {1, 3}, // T_Particles:    full, 1/2, 1/4 of emission rate
+  };
+
+FrameBudget::Scope::Scope():start(Clock::now()) {
+  }
+
+FrameBudget::Scope::Scope(Task t):task(t),start(Clock::now()) {
+  }
+
+FrameBudget::Scope::~Scope() {
+  auto  dt = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now()-start).count());
+  auto& b  = FrameBudget::inst();
+  if(task==T_Count)
+    b.frameCost      += dt; else
+    b.taskCost[task] += dt;
+  }
+
+FrameBudget& FrameBudget::inst() {
+  static FrameBudget b;
+  return b;
+  }
+
+void FrameBudget::commitFrame() {
+  commitFrame(frameCost,taskCost);
+  frameCost = 0;
+  for(auto& i:taskCost)
+    i = 0;
+  }
+
+void FrameBudget::commitFrame(uint64_t frameUs, const uint64_t* taskUs) {
+  // smooth out single spikes, like loading of texture on first use
+  avgFrame = (avgFrame*7+frameUs)/8;
+  for(size_t i=0;i<T_Count;++i)
+    avgTask[i] = (avgTask[i]*7+taskUs[i])/8;
+
+  if(cooldown>0) {
+    // let averages settle after quality change
+    --cooldown;
+    return;
+    }
+
+  const uint64_t low = (budget*85)/100;
+  if(avgFrame>budget)
+    degrade(avgFrame-budget);
+  else if(avgFrame<low)
+    restore(low-avgFrame);
+  }
+
+void FrameBudget::degrade(uint64_t over) {
+  // lower quality, starting from least important task, until expected saving covers overshoot
+  for(size_t prio=0; prio<T_Count; ++prio) {
+    for(size_t i=0;i<T_Count;++i) {
+      if(desc[i].priority!=prio || level[i]+1>=desc[i].levels)
+        continue;
+      const uint64_t save = avgTask[i]/2;
+      level[i]++;
+      cooldown = 8;
+      if(save>=over)
+        return;
+      over -= save;
+      }
+    }
+  }
+
+void FrameBudget::restore(uint64_t room) {
+  // restore one level of most important task, if doubled cost of it fits into budget
+  for(size_t prio=T_Count; prio>0; --prio) {
+    for(size_t i=0;i<T_Count;++i) {
+      if(desc[i].priority!=prio-1 || level[i]==0)
+        continue;
+      if(avgTask[i]>room)
+        return;
+      level[i]--;
+      cooldown = 8;
+      return;
+      }
+    }
+  }
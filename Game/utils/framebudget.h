@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+class FrameBudget final {
+  public:
+    // optional per-frame work, that can run with reduced quality
+    enum Task : uint8_t {
+      T_FarAnimation, // skeletal animation of npc out of near range
+      T_Particles,    // particle emission
+      T_Count
+      };
+
+    class Scope final {
+      public:
+        Scope();       // mandatory phase of frame
+        Scope(Task t); // optional task
+        ~Scope();
+
+      private:
+        using Clock = std::chrono::steady_clock;
+        Task              task=T_Count;
+        Clock::time_point start;
+      };
+
+    FrameBudget()=default; // standalone instance, for tests with fake timings
+    static FrameBudget& inst();
+
+    void     setBudget(uint64_t us) { budget = us; }
+    // 0 - full quality; each next level halves work of task
+    uint8_t  quality(Task t) const { return level[t]; }
+    void     commitFrame();
+    void     commitFrame(uint64_t frameUs, const uint64_t* taskUs);
+
+  private:
+    struct Desc {
+      uint8_t priority; // low priority tasks are degraded first
+      uint8_t levels;
+      };
+    static const Desc desc[T_Count];
+
+    void     degrade(uint64_t over);
+    void     restore(uint64_t room);
+
+    uint64_t budget=10000;
+    uint64_t frameCost=0;
+    uint64_t taskCost[T_Count]={};
+
+    uint64_t avgFrame=0;
+    uint64_t avgTask[T_Count]={};
+    uint8_t  level  [T_Count]={};
+    uint32_t cooldown=0;
+  };
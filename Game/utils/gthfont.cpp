@@ -1,17 +1,21 @@
 #include "gthfont.h"
 
 #include <Tempest/Size>
-#include "resources.h"
+#include <cstring>
+#include <iterator>
 
 using namespace Tempest;
 
-GthFont::GthFont(const char *name, const char *ftex, const Color &cl, const VDFS::FileIndex &fileIndex)
-  :fnt(name,fileIndex), color(cl) {
-  tex = Resources::loadTexture(ftex);
+GthFont::GthFont(const char *name, const Texture2d* tex, const Color &cl, const VDFS::FileIndex &fileIndex)
+  :GthFont(ZenLoad::zCFont(name,fileIndex).getFontInfo(),tex,cl) {
+  }
+
+GthFont::GthFont(const FontInfo& info, const Texture2d* tex, const Color& cl)
+  :info(info), tex(tex), color(cl) {
   }
 
 int GthFont::pixelSize() const {
-  return int(fnt.getFontInfo().fontHeight);
+  return int(info.fontHeight);
   }
 
 void GthFont::drawText(Painter &p, int bx, int by, int bw, int bh, const std::string& txtChar, AlignFlag align) const {
@@ -22,18 +26,120 @@ void GthFont::drawText(Painter &p, int bx, int by, int bw, int /*bh*/,
                        const char *txtChar, Tempest::AlignFlag align) const {
   if(tex==nullptr || txtChar==nullptr)
     return;
+  implDraw(p,bx,by,glyphRun(txtChar,bw,align));
+  }
+
+auto GthFont::glyphRun(const char* txt, int bw, AlignFlag align) const -> const std::vector<Glyph>& {
+  return layout(mkKey(txt,std::strlen(txt),bw,align,L_Wrap)).glyphs;
+  }
 
-  const uint8_t* txt = reinterpret_cast<const uint8_t*>(txtChar);
+auto GthFont::glyphRun(const char* txt) const -> const std::vector<Glyph>& {
+  return layout(mkKey(txt,std::strlen(txt),0,NoAlign,L_Line)).glyphs;
+  }
 
+void GthFont::implDraw(Painter& p, int bx, int by, const std::vector<Glyph>& glyphs) const {
   auto b = p.brush();
   p.setBrush(Brush(*tex,color));
 
-  int   h  = pixelSize();
-  int   x  = bx, y=by-h;
-  float tw = float(tex->w());
-  float th = float(tex->h());
+  const int   h  = pixelSize();
+  const float tw = float(tex->w());
+  const float th = float(tex->h());
+  for(auto& g:glyphs)
+    p.drawRect(bx+g.x,by+g.y, g.w,h,
+               tw*g.u1,th*g.v1, tw*g.u2,th*g.v2);
+
+  p.setBrush(b);
+  }
+
+GthFont::Glyph GthFont::mkGlyph(uint8_t id, int x, int y) const {
+  auto& uv1 = info.fontUV1[id];
+  auto& uv2 = info.fontUV2[id];
+
+  Glyph g;
+  g.x  = x;
+  g.y  = y;
+  g.w  = info.glyphWidth[id];
+  g.u1 = uv1.x;
+  g.v1 = uv1.y;
+  g.u2 = uv2.x;
+  g.v2 = uv2.y;
+  return g;
+  }
+
+bool GthFont::Layout::equals(const LayoutKey& k) const {
+  return kind==k.kind && width==k.width && align==k.align &&
+         text.size()==k.len && std::memcmp(text.data(),k.text,k.len)==0;
+  }
+
+GthFont::LayoutKey GthFont::mkKey(const char* txt, size_t len, int bw, AlignFlag align, LayoutKind kind) {
+  LayoutKey k;
+  k.text  = txt;
+  k.len   = len;
+  k.width = bw;
+  k.align = int(align);
+  k.kind  = kind;
+
+  // FNV-1a, over text and parameters of layout
+  uint64_t h = 14695981039346656037ull;
+  for(size_t i=0;i<len;++i) {
+    h ^= uint8_t(txt[i]);
+    h *= 1099511628211ull;
+    }
+  h ^= (uint64_t(uint32_t(bw))<<16) ^ (uint64_t(k.align)<<8) ^ uint64_t(kind);
+  h *= 1099511628211ull;
+  k.hash = size_t(h);
+  return k;
+  }
+
+auto GthFont::layout(const LayoutKey& k) const -> const Layout& {
+  auto range = layoutIndex.equal_range(k.hash);
+  for(auto it=range.first; it!=range.second; ++it) {
+    if(!it->second->equals(k))
+      continue;
+    layouts.splice(layouts.begin(),layouts,it->second);
+    return *it->second;
+    }
+
+  if(layouts.size()>=MaxLayouts) {
+    auto last = std::prev(layouts.end());
+    auto r    = layoutIndex.equal_range(last->hash);
+    for(auto it=r.first; it!=r.second; ++it)
+      if(it->second==last) {
+        layoutIndex.erase(it);
+        break;
+        }
+    layouts.pop_back();
+    }
+
+  layouts.emplace_front();
+  auto& l = layouts.front();
+  l.text.assign(k.text,k.len);
+  l.width = k.width;
+  l.align = k.align;
+  l.kind  = k.kind;
+  l.hash  = k.hash;
+
+  auto txt = reinterpret_cast<const uint8_t*>(k.text);
+  switch(k.kind) {
+    case L_Wrap:
+      implLayout(txt,k.width,AlignFlag(k.align),l.glyphs);
+      break;
+    case L_Line:
+      implLine(txt,l.glyphs);
+      break;
+    case L_Size:
+      l.size = textSize(txt,txt+k.len);
+      break;
+    }
+  layoutIndex.emplace(k.hash,layouts.begin());
+  return l;
+  }
+
+void GthFont::implLayout(const uint8_t* txt, int bw, AlignFlag align, std::vector<Glyph>& out) const {
+  int h = pixelSize();
+  int x = 0, y=-h;
 
-  int   lwidth = 0;
+  int lwidth = 0;
 
   while(*txt) {
     auto t = getLine(txt,bw,lwidth);
@@ -49,25 +155,17 @@ void GthFont::drawText(Painter &p, int bx, int by, int bw, int /*bh*/,
       }
 
     for(auto i=txt;i!=t;++i) {
-      uint8_t id  = *i;
-      auto&   uv1 = fnt.getFontInfo().fontUV1[id];
-      auto&   uv2 = fnt.getFontInfo().fontUV2[id];
-      int     w   = fnt.getFontInfo().glyphWidth[id];
-
-      p.drawRect(x,y, w,h,
-                 tw*uv1.x,th*uv1.y, tw*uv2.x,th*uv2.y);
-      x += w;
+      out.push_back(mkGlyph(*i,x,y));
+      x += out.back().w;
       }
 
     while(*t==' ')
       ++t;
 
     txt = t;
-    x = bx;
+    x = 0;
     y+= h;
     }
-
-  p.setBrush(b);
   }
 
 void GthFont::drawText(Painter &p, int x, int y, const std::string &txt) const {
@@ -77,28 +175,18 @@ void GthFont::drawText(Painter &p, int x, int y, const std::string &txt) const {
 void GthFont::drawText(Tempest::Painter &p, int bx, int by, const char *txtChar) const {
   if(tex==nullptr || txtChar==nullptr)
     return;
+  implDraw(p,bx,by,glyphRun(txtChar));
+  }
 
-  const uint8_t* txt = reinterpret_cast<const uint8_t*>(txtChar);
-
-  auto b = p.brush();
-  p.setBrush(Brush(*tex,color));
-
-  int   h  = pixelSize();
-  int   x  = bx, y=by-h;
-  float tw = float(tex->w());
-  float th = float(tex->h());
+void GthFont::implLine(const uint8_t* txt, std::vector<Glyph>& out) const {
+  // no wrapping, every byte is a glyph - even '\n'
+  int h = pixelSize();
+  int x = 0;
 
   for(size_t i=0;txt[i];++i) {
-    uint8_t id  = txt[i];
-    auto&   uv1 = fnt.getFontInfo().fontUV1[id];
-    auto&   uv2 = fnt.getFontInfo().fontUV2[id];
-    int     w   = fnt.getFontInfo().glyphWidth[id];
-
-    p.drawRect(x,y, w,h,
-               tw*uv1.x,th*uv1.y, tw*uv2.x,th*uv2.y);
-    x += w;
+    out.push_back(mkGlyph(txt[i],x,-h));
+    x += out.back().w;
     }
-  p.setBrush(b);
   }
 
 Size GthFont::textSize(const std::string &txt) const {
@@ -112,9 +200,7 @@ Size GthFont::textSize(const char *txtChar) const {
   }
 
 Size GthFont::textSize(const char* cb, const char* ce) const {
-  const uint8_t* b = reinterpret_cast<const uint8_t*>(cb);
-  const uint8_t* e = reinterpret_cast<const uint8_t*>(ce);
-  return textSize(b,e);
+  return layout(mkKey(cb,size_t(ce-cb),0,NoAlign,L_Size)).size;
   }
 
 Size GthFont::textSize(const uint8_t* b, const uint8_t* e) const {
@@ -136,7 +222,7 @@ Size GthFont::textSize(const uint8_t* b, const uint8_t* e) const {
       y+=h;
       x=0;
       } else {
-      int w = fnt.getFontInfo().glyphWidth[id];
+      int w = info.glyphWidth[id];
       x += w;
       ++i;
       }
@@ -178,7 +264,7 @@ const uint8_t* GthFont::getWord(const uint8_t *txt, int& width, int& space) cons
       return txt;
     if(id!=' ')
       break;
-    space += fnt.getFontInfo().glyphWidth[id];
+    space += info.glyphWidth[id];
     ++txt;
     }
 
@@ -187,7 +273,7 @@ const uint8_t* GthFont::getWord(const uint8_t *txt, int& width, int& space) cons
     if(id=='\0' || id=='\n' || id==' ')
       return txt;
 
-    width += fnt.getFontInfo().glyphWidth[id];
+    width += info.glyphWidth[id];
     ++txt;
     }
   }
@@ -2,12 +2,28 @@
 
 #include <zenload/zCFont.h>
 #include <Tempest/Painter>
+#include <Tempest/Size>
+
+#include <list>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class GthFont final {
   public:
-    GthFont(const char* name, const char *tex, const Tempest::Color& cl, const VDFS::FileIndex& fileIndex);
+    using FontInfo = std::decay<decltype(std::declval<const ZenLoad::zCFont&>().getFontInfo())>::type;
+
+    GthFont(const char* name, const Tempest::Texture2d* tex, const Tempest::Color& cl, const VDFS::FileIndex& fileIndex);
+    GthFont(const FontInfo& info, const Tempest::Texture2d* tex, const Tempest::Color& cl);
     GthFont(const GthFont&) = delete;
 
+    // quad of one glyph, relative to text origin; uv is normalized atlas coordinate
+    struct Glyph final {
+      int   x=0, y=0, w=0;
+      float u1=0, v1=0, u2=0, v2=0;
+      };
+
     int  pixelSize() const;
 
     void drawText(Tempest::Painter& p, int x, int y, int w, int h, const std::string& txt, Tempest::AlignFlag align) const;
@@ -20,11 +36,55 @@ class GthFont final {
     auto textSize(const char*    b, const char* e) const -> Tempest::Size;
     auto textSize(const uint8_t* b, const uint8_t* e) const -> Tempest::Size;
 
+    // glyph runs, that drawText emits; reference is valid until next call
+    auto glyphRun(const char* txt, int w, Tempest::AlignFlag align) const -> const std::vector<Glyph>&;
+    auto glyphRun(const char* txt) const -> const std::vector<Glyph>&;
+
   private:
-    ZenLoad::zCFont           fnt;
+    enum LayoutKind : uint8_t {
+      L_Wrap, // drawText in box
+      L_Line, // single line drawText
+      L_Size, // textSize
+      };
+
+    // lookup key; points to caller's text, so nothing is copied on cache hit
+    struct LayoutKey final {
+      const char* text =nullptr;
+      size_t      len  =0;
+      int         width=0;
+      int         align=0;
+      LayoutKind  kind =L_Wrap;
+      size_t      hash =0;
+      };
+
+    struct Layout final {
+      std::string        text;
+      int                width=0;
+      int                align=0;
+      LayoutKind         kind =L_Wrap;
+      size_t             hash =0;
+      std::vector<Glyph> glyphs;
+      Tempest::Size      size;
+      bool               equals(const LayoutKey& k) const;
+      };
+
+    enum { MaxLayouts = 1024 };
+
+    FontInfo                  info;
     const Tempest::Texture2d* tex=nullptr;
     Tempest::Color            color;
 
+    // UI re-draws and measures same strings every frame; keep recently used layouts
+    mutable std::list<Layout>                                          layouts;
+    mutable std::unordered_multimap<size_t,std::list<Layout>::iterator> layoutIndex;
+
+    static LayoutKey mkKey(const char* txt, size_t len, int bw, Tempest::AlignFlag align, LayoutKind kind);
+    auto           layout(const LayoutKey& k) const -> const Layout&;
+    void           implLayout(const uint8_t* txt, int bw, Tempest::AlignFlag align, std::vector<Glyph>& out) const;
+    void           implLine  (const uint8_t* txt, std::vector<Glyph>& out) const;
+    void           implDraw  (Tempest::Painter& p, int x, int y, const std::vector<Glyph>& glyphs) const;
+    Glyph          mkGlyph   (uint8_t id, int x, int y) const;
+
     const uint8_t* getLine(const uint8_t* txt, int bw, int &width) const;
     const uint8_t* getWord(const uint8_t* txt, int &width, int &space) const;
 
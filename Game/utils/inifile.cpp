@@ -36,8 +36,11 @@ void IniFile::flush() {
   std::stringstream s;
   for(auto& i:sec){
     s << "[" << i.name << "]" << std::endl << std::endl;
-    for(auto& r:i.val)
-      s << r.name << "=" << r.val << std::endl << std::endl;
+    for(auto& r:i.val) {
+      if(r.comment)
+        s << r.val << std::endl; else
+        s << r.name << "=" << r.val << std::endl << std::endl;
+      }
     s << std::endl;
     }
 
@@ -58,7 +61,7 @@ bool IniFile::has(const char *s, const char *name) {
 
 int IniFile::getI(const char *s, const char *name) {
   if(auto* val = find(s,name,false))
-    return getI(*val);
+    return val->ival;
   return 0;
   }
 
@@ -66,7 +69,8 @@ void IniFile::set(const char *sec, const char *name, int ival) {
   if(sec==nullptr || std::strlen(sec)==0 || name==nullptr || std::strlen(name)==0)
     return;
   auto& v = find(sec,name);
-  v.val = std::to_string(ival);
+  v.val  = std::to_string(ival);
+  v.ival = ival;
   changeFlag = true;
   }
 
@@ -95,7 +99,17 @@ void IniFile::implLine(std::istream &s) {
     s.get();
     std::string name = implName(s);
     addSection(std::move(name));
-    } else {
+    }
+  else if(ch==';') {
+    std::string text;
+    s.get(ch);
+    while(ch!='\n' && ch!='\r' && ch!='\0' && !s.eof()) {
+      text.push_back(ch);
+      s.get(ch);
+      }
+    addComment(std::move(text));
+    }
+  else {
     std::string name  = implName(s);
     s.get(ch);
     while(ch!='=' && ch!='\n' && ch!='\r' && ch!='\0' && !s.eof())
@@ -129,11 +143,11 @@ std::string IniFile::implName(std::istream &s) {
   }
 
 void IniFile::addSection(std::string &&name) {
-  for(auto& i:sec)
-    if(i.name==name)
-      return;
+  if(secIndex.find(name)!=secIndex.end())
+    return;
   sec.emplace_back();
   sec.back().name = std::move(name);
+  secIndex[sec.back().name] = &sec.back();
   }
 
 void IniFile::addValue(std::string &&name, std::string &&val) {
@@ -142,14 +156,39 @@ void IniFile::addValue(std::string &&name, std::string &&val) {
   addValue(sec.back(),std::move(name),std::move(val));
   }
 
-void IniFile::addValue(Section &sec, std::string &&name, std::string &&val) {
+IniFile::Value* IniFile::addValue(Section &sec, std::string &&name, std::string &&val) {
   if(name.size()==0)
-    return;
+    return nullptr;
   sec.val.emplace_back();
 
   auto& v = sec.val.back();
   v.name = std::move(name);
   v.val  = std::move(val);
+  v.ival = parseI(v.val);
+  sec.index.emplace(v.name,&v);
+  return &v;
+  }
+
+void IniFile::addComment(std::string&& text) {
+  // same as values: lines before first section are ignored
+  if(sec.size()==0)
+    return;
+  auto& s = sec.back();
+  s.val.emplace_back();
+
+  auto& v = s.val.back();
+  v.val     = std::move(text);
+  v.comment = true;
+  }
+
+IniFile::Section* IniFile::section(const char* s, bool autoCreate) {
+  auto it = secIndex.find(s);
+  if(it!=secIndex.end())
+    return it->second;
+  if(!autoCreate)
+    return nullptr;
+  addSection(s);
+  return &sec.back();
   }
 
 IniFile::Value& IniFile::find(const char *sec, const char *name) {
@@ -157,29 +196,20 @@ IniFile::Value& IniFile::find(const char *sec, const char *name) {
   }
 
 IniFile::Value* IniFile::find(const char *s, const char *name, bool autoCreate) {
-  for(auto& i:sec){
-    if(i.name==s){
-      for(auto& r:i.val)
-        if(r.name==name)
-          return &r;
-      if(autoCreate) {
-        addValue(i,name,"");
-        return &i.val.back();
-        }
-      return nullptr;
-      }
-    }
+  auto* sc = section(s,autoCreate);
+  if(sc==nullptr)
+    return nullptr;
+  auto it = sc->index.find(name);
+  if(it!=sc->index.end())
+    return it->second;
   if(!autoCreate)
     return nullptr;
-  sec.emplace_back();
-  sec.back().name = s;
-  addValue(sec.back(),name,"");
-  return &sec.back().val[0];
+  return addValue(*sc,name,"");
   }
 
-int IniFile::getI(const IniFile::Value &v) const {
+int IniFile::parseI(const std::string& v) {
   try {
-    return std::stoi(v.val);
+    return std::stoi(v);
     }
   catch(...) {
     return 0;
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <Tempest/File>
-#include <vector>
+#include <deque>
+#include <string>
+#include <unordered_map>
 
 class IniFile final {
   public:
@@ -20,11 +22,14 @@ class IniFile final {
     struct Value final {
       std::string name;
       std::string val;
+      int         ival    = 0;
+      bool        comment = false;
       };
 
-    struct Section {
-      std::string        name;
-      std::vector<Value> val;
+    struct Section final {
+      std::string                             name;
+      std::deque<Value>                       val;
+      std::unordered_map<std::string,Value*>  index;
       };
 
     void implRead(Tempest::RFile& fin);
@@ -34,12 +39,15 @@ class IniFile final {
 
     void addSection(std::string&& name);
     void addValue  (std::string&& name, std::string&& val);
-    void addValue  (Section& sec,std::string&& name, std::string&& val);
+    auto addValue  (Section& sec,std::string&& name, std::string&& val) -> Value*;
+    void addComment(std::string&& text);
+    auto section   (const char* sec,bool autoCreate) -> Section*;
     auto find      (const char* sec,const char* name) -> Value&;
     auto find      (const char* sec,const char* name,bool autoCreate) -> Value*;
-    int  getI      (const Value& v) const;
+    static int parseI(const std::string& v);
 
-    std::vector<Section> sec;
-    std::u16string       fileName;
-    bool                 changeFlag = false;
+    std::deque<Section>                       sec;
+    std::unordered_map<std::string,Section*>  secIndex;
+    std::u16string                            fileName;
+    bool                                      changeFlag = false;
   };
@@ -0,0 +1,82 @@
+#include "mappedfile.h"
+
+#include <Tempest/TextCodec>
+#include <atomic>
+#include <stdexcept>
+
+#ifdef __WINDOWS__
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static std::atomic<uint64_t> sysCount{0};
+
+uint64_t MappedFile::syscalls() {
+  return sysCount.load();
+  }
+
+MappedFile::MappedFile(const std::u16string& path) {
+#ifdef __WINDOWS__
+  sysCount.fetch_add(4);
+  hFile = CreateFileW(reinterpret_cast<const WCHAR*>(path.c_str()),GENERIC_READ,FILE_SHARE_READ,
+                      nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+  if(hFile==INVALID_HANDLE_VALUE)
+    throw std::runtime_error("unable to open file");
+
+  LARGE_INTEGER len={};
+  if(!GetFileSizeEx(hFile,&len) || len.QuadPart==0) {
+    CloseHandle(hFile);
+    throw std::runtime_error("unable to map file");
+    }
+
+  hMap = CreateFileMappingW(hFile,nullptr,PAGE_READONLY,0,0,nullptr);
+  if(hMap==nullptr) {
+    CloseHandle(hFile);
+    throw std::runtime_error("unable to map file");
+    }
+  ptr = reinterpret_cast<const uint8_t*>(MapViewOfFile(hMap,FILE_MAP_READ,0,0,0));
+  if(ptr==nullptr) {
+    CloseHandle(hMap);
+    CloseHandle(hFile);
+    throw std::runtime_error("unable to map file");
+    }
+  sz = size_t(len.QuadPart);
+#else
+  std::string p = Tempest::TextCodec::toUtf8(path);
+  sysCount.fetch_add(3);
+  fd = ::open(p.c_str(),O_RDONLY);
+  if(fd<0)
+    throw std::runtime_error("unable to open file");
+
+  struct stat st={};
+  if(fstat(fd,&st)!=0 || st.st_size==0) {
+    ::close(fd);
+    throw std::runtime_error("unable to map file");
+    }
+
+  void* m = mmap(nullptr,size_t(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+  if(m==MAP_FAILED) {
+    ::close(fd);
+    throw std::runtime_error("unable to map file");
+    }
+  ptr = reinterpret_cast<const uint8_t*>(m);
+  sz  = size_t(st.st_size);
+#endif
+  }
+
+MappedFile::~MappedFile() {
+#ifdef __WINDOWS__
+  sysCount.fetch_add(3);
+  UnmapViewOfFile(ptr);
+  CloseHandle(hMap);
+  CloseHandle(hFile);
+#else
+  sysCount.fetch_add(2);
+  munmap(const_cast<uint8_t*>(ptr),sz);
+  ::close(fd);
+#endif
+  }
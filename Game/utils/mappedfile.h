@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Tempest/Platform>
+#include <string>
+#include <cstdint>
+
+class MappedFile final {
+  public:
+    explicit MappedFile(const std::u16string& path);
+    MappedFile(const MappedFile&)=delete;
+    ~MappedFile();
+
+    const uint8_t* data() const { return ptr;  }
+    size_t         size() const { return sz;   }
+
+    // number of open/stat/map/unmap/close calls made by all instances
+    static uint64_t syscalls();
+
+  private:
+    const uint8_t* ptr=nullptr;
+    size_t         sz =0;
+#ifdef __WINDOWS__
+    void*          hFile=nullptr;
+    void*          hMap =nullptr;
+#else
+    int            fd   =-1;
+#endif
+  };
@@ -0,0 +1,145 @@
+#include "tracer.h"
+
+#include <Tempest/Log>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Event final {
+  const char* name =nullptr;
+  uint64_t    start=0;
+  uint64_t    dur  =0;
+  };
+
+struct Buffer final {
+  enum { RingSize = 64*1024 };
+
+  std::mutex         sync;
+  uint32_t           tid =0;
+  std::string        name;
+  std::vector<Event> ring;
+  uint64_t           head=0;
+
+  void push(const Event& e) {
+    std::lock_guard<std::mutex> guard(sync);
+    ring[size_t(head%RingSize)] = e;
+    ++head;
+    }
+  };
+
+std::mutex                           buffersSync;
+std::vector<std::shared_ptr<Buffer>> buffers;
+thread_local std::shared_ptr<Buffer> localBuffer;
+
+Buffer& threadBuffer() {
+  if(localBuffer==nullptr) {
+    auto b = std::make_shared<Buffer>();
+    b->ring.resize(Buffer::RingSize);
+    std::lock_guard<std::mutex> guard(buffersSync);
+    b->tid = uint32_t(buffers.size());
+    buffers.push_back(b);
+    localBuffer = std::move(b);
+    }
+  return *localBuffer;
+  }
+
+void writeString(std::ostream& out, const char* s) {
+  out << '"';
+  for(;*s;++s) {
+    if(*s=='"' || *s=='\\')
+      out << '\\';
+    out << *s;
+    }
+  out << '"';
+  }
+
+}
+
+Tracer::Zone::Zone(const char* name)
+  :name(name), start(Tracer::now()) {
+  }
+
+Tracer::Zone::~Zone() {
+  threadBuffer().push(Event{name,start,Tracer::now()-start});
+  }
+
+uint64_t Tracer::now() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  auto t = std::chrono::steady_clock::now()-epoch;
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
+  }
+
+void Tracer::setThreadName(const char* name) {
+  auto& b = threadBuffer();
+  std::lock_guard<std::mutex> guard(b.sync);
+  b.name = name;
+  }
+
+bool Tracer::write(const std::string& file) {
+  struct Ev final {
+    Event    e;
+    uint32_t tid=0;
+    };
+  std::vector<Ev>                              ev;
+  std::vector<std::pair<uint32_t,std::string>> names;
+  uint64_t                                     dropped=0;
+  {
+  std::lock_guard<std::mutex> guard(buffersSync);
+  for(auto& b:buffers) {
+    std::lock_guard<std::mutex> g(b->sync);
+    const uint64_t cnt   = std::min<uint64_t>(b->head,Buffer::RingSize);
+    const uint64_t first = b->head-cnt;
+    for(uint64_t i=first;i<b->head;++i)
+      ev.push_back(Ev{b->ring[size_t(i%Buffer::RingSize)],b->tid});
+    dropped += first;
+    names.emplace_back(b->tid,b->name);
+    }
+  }
+
+  // viewers expect parents before children, when both start at same time
+  std::sort(ev.begin(),ev.end(),[](const Ev& l,const Ev& r){
+    if(l.e.start!=r.e.start)
+      return l.e.start<r.e.start;
+    if(l.tid!=r.tid)
+      return l.tid<r.tid;
+    return l.e.dur>r.e.dur;
+    });
+
+  std::ofstream fout(file,std::ios::binary);
+  if(!fout) {
+    Tempest::Log::e("unable to write trace: \"",file,"\"");
+    return false;
+    }
+
+  char buf[128]={};
+  bool first = true;
+  fout << "{\"traceEvents\":[\n";
+  for(auto& n:names) {
+    if(n.second.empty())
+      continue;
+    fout << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << n.first << ",\"args\":{\"name\":";
+    writeString(fout,n.second.c_str());
+    fout << "}}";
+    first = false;
+    }
+  for(auto& i:ev) {
+    fout << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+    writeString(fout,i.e.name);
+    std::snprintf(buf,sizeof(buf),",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                  unsigned(i.tid),double(i.e.start)/1000.0,double(i.e.dur)/1000.0);
+    fout << buf;
+    first = false;
+    }
+  fout << "\n]}\n";
+
+  if(dropped>0)
+    Tempest::Log::i("trace: ",uint32_t(dropped)," oldest zones were overwritten");
+  return bool(fout);
+  }
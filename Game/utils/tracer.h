@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped timing zones, stored per thread in ring buffers and exported as Chrome trace_event JSON.
+// Instrumentation macros expand to nothing unless engine is built with OPENGOTHIC_TRACE.
+class Tracer final {
+  public:
+    struct Zone final {
+      Zone(const char* name);
+      Zone(const Zone&)=delete;
+      ~Zone();
+
+      const char* name =nullptr;
+      uint64_t    start=0;
+      };
+
+    static void     setThreadName(const char* name);
+    static bool     write(const std::string& file);
+    static uint64_t now();
+  };
+
+#if defined(OPENGOTHIC_TRACE)
+#define TRACE_CONCAT_(a,b) a##b
+#define TRACE_CONCAT(a,b)  TRACE_CONCAT_(a,b)
+#define TRACE_ZONE(name)   Tracer::Zone TRACE_CONCAT(traceZone,__COUNTER__)(name)
+#define TRACE_THREAD(name) Tracer::setThreadName(name)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_THREAD(name)
+#endif
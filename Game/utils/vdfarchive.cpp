@@ -0,0 +1,85 @@
+#include "vdfarchive.h"
+
+#include <stdexcept>
+#include <cstring>
+#include <cctype>
+
+namespace {
+
+enum {
+  VDF_COMMENT_LENGTH   = 256,
+  VDF_SIGNATURE_LENGTH = 16,
+  VDF_ENTRY_NAME       = 64,
+  VDF_ENTRY_DIR        = 0x80000000,
+  };
+
+#pragma pack(push,1)
+struct VdfHeader {
+  char     comment  [VDF_COMMENT_LENGTH];
+  char     signature[VDF_SIGNATURE_LENGTH];
+  uint32_t numEntries;
+  uint32_t numFiles;
+  uint32_t timestamp;
+  uint32_t dataSize;
+  uint32_t rootCatOffset;
+  uint32_t version;
+  };
+
+struct VdfEntry {
+  char     name[VDF_ENTRY_NAME];
+  uint32_t offset;
+  uint32_t size;
+  uint32_t type;
+  uint32_t attributes;
+  };
+#pragma pack(pop)
+
+// Gothic 1 and Gothic 2 variants
+const char vdfSignG1[] = "PSVDSC_V2.00\r\n\r\n";
+const char vdfSignG2[] = "PSVDSC_V2.00\n\r\n\r";
+
+}
+
+bool VdfArchive::isSignature(const char* sign, size_t len) {
+  if(len<VDF_SIGNATURE_LENGTH)
+    return false;
+  return std::memcmp(sign,vdfSignG1,VDF_SIGNATURE_LENGTH)==0 ||
+         std::memcmp(sign,vdfSignG2,VDF_SIGNATURE_LENGTH)==0;
+  }
+
+VdfArchive::VdfArchive(const std::u16string& path)
+  :file(path) {
+  VdfHeader hdr={};
+  if(file.size()<sizeof(hdr))
+    throw std::runtime_error("invalid vdf");
+  std::memcpy(&hdr,file.data(),sizeof(hdr));
+  if(!isSignature(hdr.signature,sizeof(hdr.signature)))
+    throw std::runtime_error("not a vdf archive");
+  time = int64_t(hdr.timestamp);
+
+  const size_t catEnd = size_t(hdr.rootCatOffset)+size_t(hdr.numEntries)*sizeof(VdfEntry);
+  if(catEnd>file.size())
+    throw std::runtime_error("invalid vdf catalog");
+
+  files.reserve(hdr.numFiles);
+  for(size_t i=0;i<hdr.numEntries;++i) {
+    VdfEntry e={};
+    std::memcpy(&e,file.data()+hdr.rootCatOffset+i*sizeof(VdfEntry),sizeof(e));
+    if(e.type&VDF_ENTRY_DIR)
+      continue;
+    if(size_t(e.offset)+size_t(e.size)>file.size())
+      continue;
+
+    size_t len = VDF_ENTRY_NAME;
+    while(len>0 && (e.name[len-1]==' ' || e.name[len-1]=='\0'))
+      --len;
+
+    Entry f;
+    f.name.assign(e.name,len);
+    for(auto& c:f.name)
+      c = char(std::toupper(c));
+    f.view.data = file.data()+e.offset;
+    f.view.size = e.size;
+    files.emplace_back(std::move(f));
+    }
+  }
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "mappedfile.h"
+
+class VdfArchive final {
+  public:
+    explicit VdfArchive(const std::u16string& path);
+
+    static bool isSignature(const char* sign, size_t len);
+
+    struct View final {
+      const uint8_t* data=nullptr;
+      size_t         size=0;
+      };
+
+    struct Entry final {
+      std::string name;
+      View        view;
+      };
+
+    int64_t                   timestamp() const { return time; }
+    const std::vector<Entry>& entries()   const { return files; }
+
+  private:
+    MappedFile         file;
+    int64_t            time=0;
+    std::vector<Entry> files;
+  };
@@ -1,5 +1,7 @@
 #include "workers.h"
 
+#include "tracer.h"
+
 Workers::Workers() {
   size_t id=0;
   for(auto& i:th) {
@@ -25,6 +27,7 @@ Workers &Workers::inst() {
   }
 
 void Workers::threadFunc(size_t id) {
+  TRACE_THREAD("worker");
   while(true) {
     workInc[id].acquire(1);
     if(!running) {
@@ -36,7 +39,10 @@ void Workers::threadFunc(size_t id) {
     size_t e = ((id+1)*workSize)/workTasks;
 
     void* d = &workSet[b*workEltSize];
+    {
+    TRACE_ZONE("Workers::job");
     workFunc(d,e-b);
+    }
 
     workDone.release(1);
     }
@@ -56,6 +56,7 @@ Interactive::Interactive(World &world, ZenLoad::zCVobData&& vob)
       }
     }
   setVisual(mdlVisual);
+  resolveStateFunc();
   }
 
 Interactive::Interactive(World &world)
@@ -78,6 +79,7 @@ void Interactive::load(Serialize &fin) {
   fin.read(pos,state,reverseState,loopState);
 
   setVisual(mdlVisual);
+  resolveStateFunc();
 
   uint32_t sz=0;
   fin.read(sz);
@@ -308,14 +310,23 @@ const char *Interactive::displayName() const {
   return txt;
   }
 
-void Interactive::invokeStateFunc(Npc& npc) {
-  if(onStateFunc.empty() || state<0)
+void Interactive::resolveStateFunc() {
+  stateFunc.clear();
+  if(onStateFunc.empty())
     return;
-  char func[256]={};
-  std::snprintf(func,sizeof(func),"%s_S%d",onStateFunc.c_str(),state);
+  auto& sc = world->script();
+  for(int i=0;i<=stateNum;++i) {
+    char func[256]={};
+    std::snprintf(func,sizeof(func),"%s_S%d",onStateFunc.c_str(),i);
+    stateFunc.push_back(sc.hasSymbolName(func) ? sc.getSymbolIndex(func) : size_t(-1));
+    }
+  }
 
+void Interactive::invokeStateFunc(Npc& npc) {
+  if(state<0 || size_t(state)>=stateFunc.size() || stateFunc[size_t(state)]==size_t(-1))
+    return;
   auto& sc = npc.world().script();
-  sc.useInteractive(npc.handle(),func);
+  sc.useInteractive(npc.handle(),stateFunc[size_t(state)]);
   }
 
 void Interactive::emitTriggerEvent() const {
@@ -80,6 +80,7 @@ class Interactive final {
       };
 
     void                setVisual(const std::string& visual);
+    void                resolveStateFunc();
     void                invokeStateFunc(Npc &npc);
     void                implTick(Pos &p, uint64_t dt);
     void                implQuitInteract(Pos &p);
@@ -117,6 +118,7 @@ class Interactive final {
     std::string                  useWithItem;
     std::string                  conditionFunc;
     std::string                  onStateFunc;
+    std::vector<size_t>          stateFunc; // <onStateFunc>_S<state>, by state
     bool                         rewind = false;
     //  oCMobContainer
     bool                         locked=false;
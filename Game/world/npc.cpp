@@ -14,6 +14,7 @@
 #include "utils/versioninfo.h"
 #include "graphics/animmath.h"
 #include "resources.h"
+#include "utils/tracer.h"
 
 using namespace Tempest;
 
@@ -233,6 +234,7 @@ bool Npc::setPosition(float ix, float iy, float iz) {
   z = iz;
   durtyTranform |= TR_Pos;
   physic.setPosition(x,y,z);
+  owner.onNpcMoved(*this);
   return true;
   }
 
@@ -245,6 +247,7 @@ bool Npc::setViewPosition(const Tempest::Vec3& pos) {
   y = pos.y;
   z = pos.z;
   durtyTranform |= TR_Pos;
+  owner.onNpcMoved(*this);
   return true;
   }
 
@@ -706,6 +709,7 @@ void Npc::clearSlotItem(const char *slot) {
 
 void Npc::updateWeaponSkeleton() {
   visual.updateWeaponSkeleton(invent.currentMeleWeapon(),invent.currentRangeWeapon());
+  fghAlgo.onEquipChanged();
   }
 
 void Npc::tickTimedEvt(Animation::EvCount& ev) {
@@ -1487,6 +1491,7 @@ Npc* Npc::updateNearestBody() {
   }
 
 void Npc::tick(uint64_t dt) {
+  TRACE_ZONE("Npc::tick");
   if(!visual.pose().hasAnim())
     setAnim(AnimationSolver::Idle);
 
@@ -206,6 +206,7 @@ class Npc final {
 
     void       updateAnimation();
     void       updateTransform();
+    void       setRenderShift(const Tempest::Vec3& s) { visual.setRenderShift(s); }
 
     const char*displayName() const;
     auto       displayPosition() const -> Tempest::Vec3;
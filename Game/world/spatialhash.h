@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include <Tempest/Point>
+
+template<class T>
+class SpatialHash final {
+  public:
+    SpatialHash(float cellSize=1000.f):cellSize(cellSize){}
+
+    void clear() {
+      cells.clear();
+      keys.clear();
+      nextSeq = 0;
+      }
+
+    // insertion order is order of callbacks in find
+    void insert(T& t) {
+      auto  k = keyOf(t.position());
+      auto& c = cells[k];
+      keys[&t] = Slot{k,c.size(),nextSeq};
+      c.push_back(Item{&t,nextSeq});
+      ++nextSeq;
+      }
+
+    void erase(const T& t) {
+      auto it = keys.find(&t);
+      if(it==keys.end())
+        return;
+      unlink(it->second);
+      keys.erase(it);
+      }
+
+    void update(T& t) {
+      auto it = keys.find(&t);
+      if(it==keys.end())
+        return;
+      auto k = keyOf(t.position());
+      if(k==it->second.key)
+        return;
+      unlink(it->second);
+      auto& c = cells[k];
+      it->second.key = k;
+      it->second.id  = c.size();
+      c.push_back(Item{&t,it->second.seq});
+      }
+
+    size_t size() const { return keys.size(); }
+
+    // callback may move objects, what rehashes cells: matches are collected before any call;
+    // hits are reported in insertion order, independent of cell layout
+    template<class Func>
+    void find(float x,float y,float z,float R,const Func& f) const {
+      // callback may call find again: nested query appends to buffer and drops own part on return
+      const size_t begin = hit.size();
+      scan(x,y,z,R,[this](const Item& i){ hit.push_back(i); });
+      std::sort(hit.begin()+ptrdiff_t(begin),hit.end(),[](const Item& a,const Item& b){
+        return a.seq<b.seq;
+        });
+      const size_t end = hit.size();
+      for(size_t i=begin;i<end;++i)
+        f(*hit[i].obj);
+      hit.resize(begin);
+      }
+
+    void collect(float x,float y,float z,float R,std::vector<T*>& out) const {
+      scan(x,y,z,R,[&out](const Item& i){ out.push_back(i.obj); });
+      }
+
+  private:
+    struct Slot final {
+      uint64_t key=0;
+      size_t   id =0;
+      uint64_t seq=0;
+      };
+
+    struct Item final {
+      T*       obj=nullptr;
+      uint64_t seq=0;
+      };
+
+    float                                          cellSize=1000.f;
+    std::unordered_map<uint64_t,std::vector<Item>> cells;
+    std::unordered_map<const T*,Slot>              keys;
+    uint64_t                                       nextSeq=0;
+    mutable std::vector<Item>                      hit;
+
+    template<class Emit>
+    void scan(float x,float y,float z,float R,const Emit& emit) const {
+      const int32_t x0 = cellId(x-R), x1 = cellId(x+R);
+      const int32_t z0 = cellId(z-R), z1 = cellId(z+R);
+      const float   RQ = R*R;
+      const Tempest::Vec3 p(x,y,z);
+
+      const int64_t cnt = (int64_t(x1)-x0+1)*(int64_t(z1)-z0+1);
+      if(cnt>int64_t(cells.size())) {
+        for(auto& c:cells)
+          for(auto& i:c.second)
+            if((i.obj->position()-p).quadLength()<RQ)
+              emit(i);
+        return;
+        }
+
+      for(int32_t cz=z0;cz<=z1;++cz)
+        for(int32_t cx=x0;cx<=x1;++cx) {
+          auto c = cells.find(packKey(cx,cz));
+          if(c==cells.end())
+            continue;
+          for(auto& i:c->second)
+            if((i.obj->position()-p).quadLength()<RQ)
+              emit(i);
+          }
+      }
+
+    void unlink(const Slot& s) {
+      auto& c = cells[s.key];
+      if(s.id+1!=c.size()) {
+        c[s.id] = c.back();
+        keys[c[s.id].obj].id = s.id;
+        }
+      c.pop_back();
+      if(c.empty())
+        cells.erase(s.key);
+      }
+
+    int32_t cellId(float v) const {
+      return int32_t(std::floor(v/cellSize));
+      }
+
+    static uint64_t packKey(int32_t x,int32_t z) {
+      return (uint64_t(uint32_t(x))<<32) | uint64_t(uint32_t(z));
+      }
+
+    uint64_t keyOf(const Tempest::Vec3& p) const {
+      return packKey(cellId(p.x),cellId(p.z));
+      }
+  };
@@ -37,6 +37,7 @@ StaticObj::StaticObj(const ZenLoad::zCVobData& vob,World& owner) {
       // single particle
       }
     } else {
+    Resources::WorldScope scope;
     auto view = Resources::loadMesh(vob.visual);
     if(!view)
       return;
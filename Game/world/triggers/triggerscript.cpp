@@ -4,11 +4,18 @@
 
 TriggerScript::TriggerScript(ZenLoad::zCVobData&& data, World &owner)
   :AbstractTrigger(std::move(data),owner){
+  auto& sc = owner.script();
+  if(sc.hasSymbolName(this->data.zCTriggerScript.scriptFunc.c_str()))
+    scriptFn = sc.getSymbolIndex(this->data.zCTriggerScript.scriptFunc);
   }
 
 void TriggerScript::onTrigger(const TriggerEvent &) {
+  if(scriptFn==size_t(-1)) {
+    Tempest::Log::e("exception in trigger-script: ","script bad call");
+    return;
+    }
   try {
-    owner.script().runFunction(data.zCTriggerScript.scriptFunc.c_str());
+    owner.script().runFunction(scriptFn);
     }
   catch(std::runtime_error& e){
     Tempest::Log::e("exception in trigger-script: ",e.what());
@@ -9,4 +9,7 @@ class TriggerScript : public AbstractTrigger {
     TriggerScript(ZenLoad::zCVobData&& data, World &owner);
 
     void onTrigger(const TriggerEvent& evt) override;
+
+  private:
+    size_t scriptFn=size_t(-1);
   };
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <functional>
 
+#include <Tempest/Application>
 #include <Tempest/Log>
 #include <Tempest/Painter>
 
@@ -14,14 +15,27 @@
 #include "graphics/submesh/packedmesh.h"
 #include "graphics/visualfx.h"
 #include "graphics/skeleton.h"
+#include "utils/fileext.h"
+#include "utils/workers.h"
+#include "utils/tracer.h"
 
 using namespace Tempest;
 
+static void logIoStats(const Resources::IoStats& begin) {
+  auto io = Resources::ioStats();
+  Log::i("io: copied ",uint32_t((io.copyBytes-begin.copyBytes)/1024),"kb in ",uint32_t(io.copyCount-begin.copyCount)," reads, ",
+         "mapped ",uint32_t((io.viewBytes-begin.viewBytes)/1024),"kb in ",uint32_t(io.viewCount-begin.viewCount)," views, ",
+         uint32_t(io.sysCalls-begin.sysCalls)," file syscalls");
+  }
+
 World::World(Gothic& gothic, GameSession& game,const RendererStorage &storage, std::string file, uint8_t isG2, std::function<void(int)> loadProgress)
   :wname(std::move(file)),game(game),wsound(gothic,game,*this),wobj(*this) {
   using namespace Daedalus::GameState;
+  const auto io = Resources::ioStats();
+  Resources::beginWorld();
 
-  ZenLoad::ZenParser parser(wname,Resources::vdfsIndex());
+  auto               data = Resources::getFileData(wname);
+  ZenLoad::ZenParser parser(data.data(),data.size());
 
   loadProgress(1);
   parser.readHeader();
@@ -39,6 +53,8 @@ World::World(Gothic& gothic, GameSession& game,const RendererStorage &storage, s
   loadProgress(70);
 
   wmatrix.reset(new WayMatrix(*this,world.waynet));
+  prefetchVobs(world.rootVobs);
+  prefetchFx  (world.rootVobs);
   if(1){
     for(auto& vob:world.rootVobs)
       loadVob(vob,true);
@@ -48,6 +64,7 @@ World::World(Gothic& gothic, GameSession& game,const RendererStorage &storage, s
   bspSectors.resize(bsp.sectors.size());
 
   wobj.triggerOnStart(true);
+  logIoStats(io);
   loadProgress(100);
   }
 
@@ -55,8 +72,11 @@ World::World(Gothic& gothic, GameSession &game, const RendererStorage &storage,
              Serialize &fin, uint8_t isG2, std::function<void(int)> loadProgress)
   :wname(fin.read<std::string>()),game(game),wsound(gothic,game,*this),wobj(*this) {
   using namespace Daedalus::GameState;
+  const auto io = Resources::ioStats();
+  Resources::beginWorld();
 
-  ZenLoad::ZenParser parser(wname,Resources::vdfsIndex());
+  auto               data = Resources::getFileData(wname);
+  ZenLoad::ZenParser parser(data.data(),data.size());
 
   loadProgress(1);
   parser.readHeader();
@@ -74,6 +94,8 @@ World::World(Gothic& gothic, GameSession &game, const RendererStorage &storage,
   loadProgress(70);
 
   wmatrix.reset(new WayMatrix(*this,world.waynet));
+  prefetchVobs(world.rootVobs);
+  prefetchFx  (world.rootVobs);
   if(1){
     for(auto& vob:world.rootVobs)
       loadVob(vob,false);
@@ -83,6 +105,7 @@ World::World(Gothic& gothic, GameSession &game, const RendererStorage &storage,
   bspSectors.resize(bsp.sectors.size());
 
   wobj.triggerOnStart(false);
+  logIoStats(io);
   loadProgress(100);
   }
 
@@ -286,6 +309,7 @@ World::BspSector* World::portalAt(const std::string &tag) {
   }
 
 void World::tick(uint64_t dt) {
+  TRACE_ZONE("World::tick");
   static bool doTicks=true;
   if(!doTicks)
     return;
@@ -744,16 +768,8 @@ const WayPoint *World::findNextPoint(const WayPoint &pos) const {
   return wmatrix->findNextPoint(pos.x,pos.y,pos.z);
   }
 
-void World::detectNpcNear(std::function<void (Npc &)> f) {
-  wobj.detectNpcNear(f);
-  }
-
-void World::detectNpc(const Tempest::Vec3& p, const float r, std::function<void (Npc &)> f) {
-  wobj.detectNpc(p.x,p.y,p.z,r,f);
-  }
-
-void World::detectNpc(const float x, const float y, const float z, const float r, std::function<void(Npc&)> f) {
-  wobj.detectNpc(x,y,z,r,f);
+void World::onNpcMoved(Npc& npc) {
+  wobj.onNpcMoved(npc);
   }
 
 WayPath World::wayTo(const Npc &pos, const WayPoint &end) const {
@@ -829,6 +845,80 @@ MeshObjects::Mesh World::getView(const Daedalus::ZString& visual) const {
   return getView(visual.c_str());
   }
 
+void World::prefetchVobs(const std::vector<ZenLoad::zCVobData>& vobs) {
+  // decode vob meshes on worker threads, so sequential loadVob hits warm caches
+  std::unordered_set<std::string> uniq;
+  std::vector<std::string>        visual;
+
+  std::function<void(const std::vector<ZenLoad::zCVobData>&)> collect;
+  collect = [&](const std::vector<ZenLoad::zCVobData>& v) {
+    for(auto& i:v) {
+      collect(i.childVobs);
+      if(i.visual.empty() || FileExt::hasExt(i.visual,"PFX") || FileExt::hasExt(i.visual,"TGA"))
+        continue;
+      if(uniq.insert(i.visual).second)
+        visual.push_back(i.visual);
+      }
+    };
+  collect(vobs);
+
+  auto time = Application::tickCount();
+  Workers::parallelFor(visual,[](std::string& name){
+    Resources::WorldScope scope;
+    Resources::loadMesh(name);
+    });
+  time = Application::tickCount()-time;
+  Log::i("prefetch: ",uint32_t(visual.size())," meshes in ",uint32_t(time),"ms [threads: ",uint32_t(std::thread::hardware_concurrency()),"]");
+  }
+
+void World::prefetchFx(const std::vector<ZenLoad::zCVobData>& vobs) {
+  // instantiate effects of vobs and spells at load time, instead of first cast/activation in game
+  std::unordered_set<std::string> uniq;
+  std::vector<std::string>        pfx;
+
+  std::function<void(const std::vector<ZenLoad::zCVobData>&)> collect;
+  collect = [&](const std::vector<ZenLoad::zCVobData>& v) {
+    for(auto& i:v) {
+      collect(i.childVobs);
+      if(!FileExt::hasExt(i.visual,"PFX"))
+        continue;
+      auto name = i.visual.substr(0,i.visual.size()-4);
+      if(uniq.insert(name).second)
+        pfx.push_back(std::move(name));
+      }
+    };
+  collect(vobs);
+
+  auto time = Application::tickCount();
+  auto vfx  = script().spellVFxNames();
+  game.prefetchFx(vfx,std::move(pfx),true);
+  time = Application::tickCount()-time;
+  Log::i("prefetch: ",uint32_t(vfx.size())," spell effects, ",uint32_t(uniq.size())," particle vobs in ",uint32_t(time),"ms");
+  }
+
+void World::prefetchItemFx() {
+  // item effects (glowing runes, magic arrows), of npc equipment and items on ground
+  std::unordered_set<std::string> uniq;
+  std::vector<std::string>        vfx;
+  auto add = [&](const Item& it) {
+    auto& fx = it.handle()->effect;
+    if(!fx.empty() && uniq.insert(fx.c_str()).second)
+      vfx.push_back(fx.c_str());
+    };
+  for(size_t i=0;i<wobj.npcCount();++i) {
+    auto& inv = wobj.npc(i).inventory();
+    for(size_t r=0;r<inv.recordsCount();++r)
+      add(inv.at(r));
+    }
+  for(size_t i=0;i<wobj.itmCount();++i)
+    add(wobj.itm(i));
+
+  auto time = Application::tickCount();
+  game.prefetchFx(vfx,{},false);
+  time = Application::tickCount()-time;
+  Log::i("prefetch: ",uint32_t(vfx.size())," item effects in ",uint32_t(time),"ms");
+  }
+
 void World::loadVob(ZenLoad::zCVobData &vob,bool startup) {
   for(auto& i:vob.childVobs)
     loadVob(i,startup);
@@ -910,8 +1000,10 @@ void World::loadVob(ZenLoad::zCVobData &vob,bool startup) {
   else if(vob.objectClass=="oCTouchDamage:zCTouchDamage:zCVob"){
     // NOT IMPLEMENTED
     }
-  else if(vob.objectClass=="zCVobLight:zCVob" ||
-          vob.objectClass=="zCVobLensFlare:zCVob" ||
+  else if(vob.objectClass=="zCVobLight:zCVob") {
+    wview->addLight(vob);
+    }
+  else if(vob.objectClass=="zCVobLensFlare:zCVob" ||
           vob.objectClass=="zCZoneVobFarPlane:zCVob" ||
           vob.objectClass=="zCZoneVobFarPlaneDefault:zCZoneVobFarPlane:zCVob" ||
           vob.objectClass=="zCZoneZFog:zCVob" ||
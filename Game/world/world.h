@@ -68,9 +68,13 @@ class World final {
     const WayPoint* findNextFreePoint(const Npc& pos,const char* name) const;
     const WayPoint* findNextPoint(const WayPoint& pos) const;
 
-    void            detectNpcNear(std::function<void(Npc&)> f);
-    void            detectNpc(const Tempest::Vec3& p, const float r, std::function<void(Npc&)> f);
-    void            detectNpc(const float x, const float y, const float z, const float r, std::function<void(Npc&)> f);
+    template<class Func>
+    void            detectNpcNear(const Func& f) { wobj.detectNpcNear(f); }
+    template<class Func>
+    void            detectNpc(const Tempest::Vec3& p, const float r, const Func& f) { wobj.detectNpc(p.x,p.y,p.z,r,f); }
+    template<class Func>
+    void            detectNpc(const float x, const float y, const float z, const float r, const Func& f) { wobj.detectNpc(x,y,z,r,f); }
+    void            onNpcMoved(Npc& npc);
 
     WayPath         wayTo(const Npc& pos,const WayPoint& end) const;
     WayPath         wayTo(float npcX,float npcY,float npcZ,const WayPoint& end) const;
@@ -100,6 +104,7 @@ class World final {
 
     void                 updateAnimation();
     void                 resetPositionToTA();
+    void                 prefetchItemFx();
 
     auto                 takeHero() -> std::unique_ptr<Npc>;
     Npc*                 player() const { return npcPlayer; }
@@ -175,6 +180,8 @@ class World final {
     WorldObjects                          wobj;
     std::unique_ptr<Npc>                  lvlInspector;
 
+    void         prefetchVobs(const std::vector<ZenLoad::zCVobData>& vobs);
+    void         prefetchFx  (const std::vector<ZenLoad::zCVobData>& vobs);
     void         loadVob(ZenLoad::zCVobData &vob, bool startup);
     auto         roomAt(const ZenLoad::zCBspNode &node) -> const std::string &;
     auto         portalAt(const std::string& tag) -> BspSector*;
@@ -5,7 +5,9 @@
 #include "item.h"
 #include "npc.h"
 #include "world.h"
+#include "utils/framebudget.h"
 #include "utils/workers.h"
+#include "utils/tracer.h"
 
 #include "world/triggers/codemaster.h"
 #include "world/triggers/triggerscript.h"
@@ -31,10 +33,13 @@ void WorldObjects::load(Serialize &fin) {
 
   fin.read(sz);
   npcArr.clear();
+  npcIndex.clear();
   for(size_t i=0;i<sz;++i)
     npcArr.emplace_back(std::make_unique<Npc>(owner,size_t(-1),nullptr));
-  for(auto& i:npcArr)
+  for(auto& i:npcArr) {
     i->load(fin);
+    npcIndex.insert(*i);
+    }
 
   fin.read(sz);
   itemArr.clear();
@@ -69,6 +74,7 @@ void WorldObjects::save(Serialize &fout) {
   }
 
 void WorldObjects::tick(uint64_t dt) {
+  TRACE_ZONE("WorldObjects::tick");
   auto passive=std::move(sndPerc);
   sndPerc.clear();
 
@@ -176,6 +182,7 @@ Npc *WorldObjects::addNpc(size_t npcInstance, const Daedalus::ZString& at) {
     }
 
   npcArr.emplace_back(npc);
+  npcIndex.insert(*npc);
   return npc;
   }
 
@@ -198,6 +205,7 @@ Npc* WorldObjects::insertPlayer(std::unique_ptr<Npc> &&npc, const Daedalus::ZStr
     npc->updateTransform();
     }
   npcArr.emplace_back(std::move(npc));
+  npcIndex.insert(*npcArr.back());
   return npcArr.back().get();
   }
 
@@ -205,9 +213,10 @@ std::unique_ptr<Npc> WorldObjects::takeNpc(const Npc* ptr) {
   for(size_t i=0; i<npcArr.size(); ++i){
     auto& npc=*npcArr[i];
     if(&npc==ptr){
+      npcIndex.erase(npc);
       auto ret=std::move(npcArr[i]);
-      npcArr[i] = std::move(npcArr.back());
-      npcArr.pop_back();
+      // keep order of npcArr, it's also order of npcIndex queries
+      npcArr.erase(npcArr.begin()+int(i));
       return ret;
       }
     }
@@ -246,11 +255,28 @@ void WorldObjects::tickTriggers(uint64_t /*dt*/) {
     }
   }
 
+static bool isFar(const Npc& npc) {
+  return npc.processPolicy()==Npc::AiFar || npc.processPolicy()==Npc::AiFar2;
+  }
+
 void WorldObjects::updateAnimation() {
   Workers::parallelFor(npcArr,[](std::unique_ptr<Npc>& i){
     i->updateTransform();
-    i->updateAnimation();
+    if(!isFar(*i))
+      i->updateAnimation();
     });
+
+  {
+  // far npc are optional work: under load only every n-th of them is animated in frame
+  FrameBudget::Scope scope(FrameBudget::T_FarAnimation);
+  const size_t step  = size_t(1) << FrameBudget::inst().quality(FrameBudget::T_FarAnimation);
+  const size_t phase = (animFrame++)%step;
+  const auto*  arr   = npcArr.data();
+  Workers::parallelFor(npcArr,[arr,step,phase](std::unique_ptr<Npc>& i){
+    if(isFar(*i) && size_t(&i-arr)%step==phase)
+      i->updateAnimation();
+    });
+  }
   Workers::parallelFor(interactiveObj.begin(),interactiveObj.end(),[](Interactive& i){
     i.updateAnimation();
     });
@@ -290,19 +316,8 @@ Npc *WorldObjects::findNpcByInstance(size_t instance) {
   return nullptr;
   }
 
-void WorldObjects::detectNpcNear(std::function<void (Npc &)> f) {
-  for(auto& i:npcNear)
-    f(*i);
-  }
-
-void WorldObjects::detectNpc(const float x, const float y, const float z,
-                             const float r, std::function<void (Npc &)> f) {
-  float maxDist=r*r;
-  for(auto& i:npcArr) {
-    auto qDist = (i->position()-Vec3(x,y,z)).quadLength();
-    if(qDist<maxDist)
-      f(*i);
-    }
+void WorldObjects::onNpcMoved(Npc& npc) {
+  npcIndex.update(npc);
   }
 
 void WorldObjects::addTrigger(ZenLoad::zCVobData&& vob) {
@@ -588,6 +603,7 @@ void WorldObjects::resetPositionToTA() {
     if(n.resetPositionToTA()){
       ++i;
       } else {
+      npcIndex.erase(n);
       npcInvalid.emplace_back(std::move(npcArr[i]));
       npcArr.erase(npcArr.begin()+int(i));
 
@@ -8,6 +8,7 @@
 #include "bullet.h"
 #include "interactive.h"
 #include "spaceindex.h"
+#include "spatialhash.h"
 #include "staticobj.h"
 #include "game/perceptionmsg.h"
 #include "triggers/movetrigger.h"
@@ -59,8 +60,17 @@ class WorldObjects final {
     size_t         npcCount()    const { return npcArr.size(); }
     const Npc&     npc(size_t i) const { return *npcArr[i];    }
     Npc&           npc(size_t i)       { return *npcArr[i];    }
-    void           detectNpcNear(std::function<void(Npc&)> f);
-    void           detectNpc(const float x,const float y,const float z,const float r,std::function<void(Npc&)> f);
+    void           onNpcMoved(Npc& npc);
+
+    template<class Func>
+    void           detectNpcNear(const Func& f) {
+      for(auto& i:npcNear)
+        f(*i);
+      }
+    template<class Func>
+    void           detectNpc(const float x,const float y,const float z,const float r,const Func& f) {
+      npcIndex.find(x,y,z,r,f);
+      }
 
     size_t         itmCount()    const { return itemArr.size(); }
     Item&          itm(size_t i)       { return *itemArr[i];    }
@@ -109,6 +119,7 @@ class WorldObjects final {
     std::vector<std::unique_ptr<Npc>>  npcArr;
     std::vector<std::unique_ptr<Npc>>  npcInvalid;
     std::vector<Npc*>                  npcNear;
+    SpatialHash<Npc>                   npcIndex;
 
     std::vector<std::unique_ptr<AbstractTrigger>> triggers;
     std::vector<AbstractTrigger*>                 triggersZn;
@@ -116,6 +127,7 @@ class WorldObjects final {
 
     std::vector<PerceptionMsg>         sndPerc;
     std::vector<TriggerEvent>          triggerEvents;
+    size_t                             animFrame=0;
 
     template<class T,class E>
     E*   validateObj(T &src,E* e);
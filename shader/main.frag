@@ -15,6 +15,7 @@ layout(location = 3) in vec4 inColor;
 layout(location = 4) in vec3 inLight;
 layout(location = 5) in vec3 inAmbient;
 layout(location = 6) in vec3 inSun;
+layout(location = 7) in vec4 inShadowPos1;
 #endif
 
 layout(location = 0) out vec4 outColor;
@@ -52,7 +53,7 @@ float calcShadow(vec3 shPos0, vec3 shPos1) {
   if(abs(shPos0.x)<0.99 && abs(shPos0.y)<0.99)
     return shadowVal(shPos0.xy*vec2(0.5,0.5)+vec2(0.5),shPos0.z,0);
 
-  if(abs(shPos1.x)<0.99 && abs(shPos1.y)<0.99)
+  if(abs(shPos1.x)<0.99 && abs(shPos1.y)<0.99 && shPos1.z<0.99)
     return implShadowVal(shPos1.xy*vec2(0.5,0.5)+vec2(0.5),shPos1.z,1);
 
   return 1.0;
@@ -73,7 +74,7 @@ void main() {
 #ifndef PFX
   float lambert = max(0.0,dot(inLight,normalize(inNormal)));
   vec3  shPos0  = (inShadowPos.xyz)/inShadowPos.w;
-  vec3  shPos1  = shPos0*0.2;
+  vec3  shPos1  = (inShadowPos1.xyz)/inShadowPos1.w;
   float light   = lambert;
   light *= calcShadow(shPos0,shPos1);
   vec3  color   = (inAmbient+inSun*inColor.rgb*clamp(light,0.0,1.0));
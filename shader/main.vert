@@ -11,6 +11,7 @@ layout(std140,binding = 0) uniform UboScene {
   mat4 shadow;
   vec3 ambient;
   vec4 sunCl;
+  mat4 shadow1;
   } scene;
 
 #if defined(OBJ) || defined(SKINING)
@@ -52,6 +53,7 @@ layout(location = 3) out vec4 outColor;
 layout(location = 4) out vec3 outLight;
 layout(location = 5) out vec3 outAmbient;
 layout(location = 6) out vec3 outSun;
+layout(location = 7) out vec4 outShadowPos1;
 #endif
 
 vec4 vertexPos() {
@@ -92,27 +94,29 @@ void main() {
 
   vec4 pos   = vertexPos();
 #ifdef OBJ
-  vec4 shPos = scene.shadow*ubo.obj*pos;
+  vec4 wPos  = ubo.obj*pos;
 #else
-  vec4 shPos = scene.shadow*pos;
+  vec4 wPos  = pos;
 #endif
+  vec4 shPos = scene.shadow*wPos;
 
 #ifdef SHADOW_MAP
   outShadowPos = shPos;
   gl_Position  = shPos;
 #else
   vec4 norm = normal();
-  outShadowPos = shPos;
-  outColor     = inColor;
-  outLight     = scene.ldir;
-  outAmbient   = scene.ambient.rgb;
-  outSun       = scene.sunCl.rgb;
+  outShadowPos  = shPos;
+  outShadowPos1 = scene.shadow1*wPos;
+  outColor      = inColor;
+  outLight      = scene.ldir;
+  outAmbient    = scene.ambient.rgb;
+  outSun        = scene.sunCl.rgb;
 #  ifdef OBJ
-  outNormal    = (ubo.obj*norm).xyz;
-  gl_Position  = scene.mv*ubo.obj*pos;
+  outNormal     = (ubo.obj*norm).xyz;
+  gl_Position   = scene.mv*ubo.obj*pos;
 #  else
-  outNormal    = norm.xyz;
-  gl_Position  = scene.mv*pos;
+  outNormal     = norm.xyz;
+  gl_Position   = scene.mv*pos;
 #  endif
 #endif
   }